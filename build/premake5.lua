@@ -43,6 +43,56 @@ newoption
     default = "off"
 }
 
+newoption
+{
+    trigger = "embed-assets",
+    description = "Embed the assets folder into the executable (no filesystem lookups at startup)"
+}
+
+newoption
+{
+    trigger = "count-allocations",
+    description = "Count heap allocations in release builds too (perf overlay, --alloc-check)"
+}
+
+-- Vygeneruje build_files/generated/EmbeddedAssets.cpp s obsahem všech souborů v ../assets
+-- (po změně assetů je potřeba premake spustit znovu)
+function generate_embedded_assets()
+    local asset_root = path.getabsolute("../assets")
+    local asset_files = os.matchfiles(asset_root .. "/**")
+    table.sort(asset_files)
+
+    os.mkdir("build_files/generated")
+    local out = io.open("build_files/generated/EmbeddedAssets.cpp", "w")
+    out:write("// Vygenerováno premake (--embed-assets) - neupravovat\n")
+    out:write("#include \"EmbeddedAssets.hpp\"\n\n")
+
+    local sizes = {}
+    for index, file in ipairs(asset_files) do
+        local input = io.open(file, "rb")
+        local data = input:read("*a")
+        input:close()
+        sizes[index] = #data
+
+        -- Koncová 0 jen kvůli prázdným souborům, do velikosti se nepočítá
+        out:write("static const unsigned char asset_" .. index .. "[] = {\n")
+        for i = 1, #data, 24 do
+            out:write("    " .. table.concat({string.byte(data, i, math.min(i + 23, #data))}, ",") .. ",\n")
+        end
+        out:write("    0\n};\n\n")
+    end
+
+    out:write("const EmbeddedAsset EMBEDDED_ASSETS[] = {\n")
+    for index, file in ipairs(asset_files) do
+        local name = path.getrelative(asset_root, file)
+        out:write("    {\"" .. name .. "\", asset_" .. index .. ", " .. sizes[index] .. "},\n")
+    end
+    out:write("    {nullptr, nullptr, 0}\n};\n")
+    out:write("const int EMBEDDED_ASSET_COUNT = " .. #asset_files .. ";\n")
+    out:close()
+    print("Embedded " .. #asset_files .. " asset files")
+end
+
 function download_progress(total, current)
     local ratio = current / total;
     ratio = math.min(math.max(ratio, 0), 1);
@@ -166,6 +216,10 @@ if (downloadRaylib) then
     build_externals()
     end
 
+if (_OPTIONS["embed-assets"]) then
+    generate_embedded_assets()
+    end
+
     startproject(workspaceName)
 
     project (workspaceName)
@@ -205,6 +259,15 @@ if (downloadRaylib) then
         includedirs { "../src" }
         includedirs { "../include" }
 
+        filter "options:embed-assets"
+            defines { "SANDTRIX_EMBED_ASSETS" }
+            files { "build_files/generated/EmbeddedAssets.cpp" }
+        filter{}
+
+        filter "options:count-allocations"
+            defines { "SANDTRIX_COUNT_ALLOCATIONS" }
+        filter{}
+
         links {"raylib"}
 
         cdialect "C17"
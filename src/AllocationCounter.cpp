@@ -0,0 +1,66 @@
+#include "AllocationCounter.hpp"
+
+#if defined(DEBUG) || defined(SANDTRIX_COUNT_ALLOCATIONS)
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+std::atomic<unsigned long long> allocation_count(0);  // Alokace ze všech vláken
+
+void* CountedAlloc(std::size_t size) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (size == 0) size = 1;
+    return std::malloc(size);
+}
+}
+
+// Ostatní varianty (pole, nothrow, sized delete) standardní knihovna převádí na tyto
+void* operator new(std::size_t size) {
+    void* ptr = CountedAlloc(size);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new[](std::size_t size) {
+    void* ptr = CountedAlloc(size);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+bool IsAllocationCountingEnabled() {
+    return true;
+}
+
+unsigned long long GetAllocationCount() {
+    return allocation_count.load(std::memory_order_relaxed);
+}
+
+#else
+
+bool IsAllocationCountingEnabled() {
+    return false;
+}
+
+unsigned long long GetAllocationCount() {
+    return 0;
+}
+
+#endif
@@ -0,0 +1,20 @@
+#pragma once
+
+/**
+ * Počítadlo alokací na haldě pro kontrolu ustálené herní smyčky.
+ *
+ * V ladicím sestavení (DEBUG) nebo s volbou premake --count-allocations
+ * (SANDTRIX_COUNT_ALLOCATIONS) nahrazuje AllocationCounter.cpp globální
+ * operator new a počítá každou alokaci ze všech vláken. Jinak se nic
+ * nenahrazuje a počet je vždy 0.
+ */
+
+/**
+ * @return true pokud se alokace počítají
+ */
+bool IsAllocationCountingEnabled();
+
+/**
+ * @return Počet alokací od startu programu (0 pokud se nepočítají)
+ */
+unsigned long long GetAllocationCount();
@@ -0,0 +1,75 @@
+#include "Assets.hpp"
+#include "raylib.h"
+#include <cstring>
+
+#ifdef SANDTRIX_EMBED_ASSETS
+#include "EmbeddedAssets.hpp"
+#endif
+
+Assets::Assets() : music_data(nullptr), music_size(0), music_file(nullptr), loading_started(false), pending_jobs(0) {}
+
+Assets::~Assets() {
+    if (music_file) UnloadFileData(music_file);
+}
+
+std::string Assets::ResolvePath(const char* name) {
+    std::string app_dir = GetApplicationDirectory();
+    const std::string candidates[] = {
+        app_dir + "assets/" + name,
+        app_dir + "../../assets/" + name,
+        std::string("assets/") + name
+    };
+    for (const std::string& path : candidates) {
+        if (FileExists(path.c_str())) return path;
+    }
+    return candidates[2];
+}
+
+const unsigned char* Assets::ReadAsset(const char* name, int& size, unsigned char*& file_data) {
+    file_data = nullptr;
+    size = 0;
+#ifdef SANDTRIX_EMBED_ASSETS
+    for (int i = 0; i < EMBEDDED_ASSET_COUNT; i++) {
+        if (std::strcmp(EMBEDDED_ASSETS[i].name, name) == 0) {
+            size = (int)EMBEDDED_ASSETS[i].size;
+            return EMBEDDED_ASSETS[i].data;
+        }
+    }
+    return nullptr;
+#else
+    std::string path = ResolvePath(name);
+    if (!FileExists(path.c_str())) return nullptr;
+    file_data = LoadFileData(path.c_str(), &size);
+    return file_data;
+#endif
+}
+
+void Assets::StartLoading(ThreadPool& pool) {
+    loading_started = true;
+    pending_jobs = 2 + (int)SfxId::COUNT;
+
+    // Otevření audio zařízení trvá i stovky ms - nezávisí na oknu ani OpenGL
+    pool.Submit([this] {
+        InitAudioDevice();
+        pending_jobs--;
+    });
+
+    pool.Submit([this] {
+        music_data = ReadAsset("music.ogg", music_size, music_file);
+        if (!music_data) TraceLog(LOG_WARNING, "ASSETS: music.ogg not found");
+        pending_jobs--;
+    });
+
+    for (int i = 0; i < (int)SfxId::COUNT; i++) {
+        pool.Submit([this, i] {
+            SfxId id = (SfxId)i;
+            std::string name = std::string("sfx/") + SfxMixer::GetClipName(id) + ".wav";
+            int size = 0;
+            unsigned char* file_data = nullptr;
+            const unsigned char* data = ReadAsset(name.c_str(), size, file_data);
+            if (!data || !SfxMixer::DecodeClip(data, size, sfx_pcm[i])) sfx_pcm[i] = SfxMixer::SynthesizeClip(id);
+            if (file_data) UnloadFileData(file_data);
+            pending_jobs--;
+        });
+    }
+}
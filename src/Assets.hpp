@@ -0,0 +1,67 @@
+#pragma once
+
+#include "SfxMixer.hpp"
+#include "ThreadPool.hpp"
+#include <atomic>
+#include <string>
+#include <vector>
+
+/**
+ * Herní assety načítané na pracovních vláknech během úvodní animace.
+ *
+ * Načítání zahrnuje inicializaci audio zařízení, načtení hudby do paměti
+ * (dekóduje ji pak po částech AudioThread) a převod všech zvukových efektů
+ * na PCM. Soubory se hledají vedle spustitelného souboru, ne v pracovním
+ * adresáři. Při sestavení s volbou --embed-assets (SANDTRIX_EMBED_ASSETS)
+ * se místo souborů použijí data vložená do binárky a start se na disk
+ * vůbec nedívá.
+ */
+class Assets {
+public:
+    const unsigned char* music_data;                 // Zakódovaná hudba (OGG) v paměti
+    int music_size;                                  // Velikost hudby v bajtech
+    std::vector<float> sfx_pcm[(int)SfxId::COUNT];   // PCM zvukových efektů
+
+    Assets();
+
+    /**
+     * Destruktor - uvolní načtené soubory (načítání musí být dokončené).
+     */
+    ~Assets();
+
+    Assets(const Assets&) = delete;
+    Assets& operator=(const Assets&) = delete;
+
+    /**
+     * Zařadí načítání do poolu a hned se vrátí.
+     * @param pool Pracovní vlákna
+     */
+    void StartLoading(ThreadPool& pool);
+
+    /**
+     * @return true pokud je vše načtené a audio zařízení připravené
+     */
+    bool IsReady() const { return loading_started && pending_jobs.load() == 0; }
+
+    /**
+     * Najde soubor assetu - vedle spustitelného souboru, v kořeni projektu
+     * (bin/<konfigurace>/../../assets) a nakonec v pracovním adresáři.
+     * @param name Cesta relativně k assets/
+     * @return Nalezená cesta (nebo poslední zkoušená, pokud soubor neexistuje)
+     */
+    static std::string ResolvePath(const char* name);
+
+private:
+    unsigned char* music_file;           // Hudba načtená ze souboru (nullptr u vložených dat)
+    bool loading_started;                // StartLoading už proběhl
+    std::atomic<int> pending_jobs;       // Počet nedokončených úloh
+
+    /**
+     * Získá obsah assetu - z vložených dat, jinak ze souboru.
+     * @param name Cesta relativně k assets/
+     * @param size Výstup - velikost dat
+     * @param file_data Výstup - data načtená ze souboru (uvolnit přes UnloadFileData), nullptr u vložených
+     * @return Data, nebo nullptr pokud asset neexistuje
+     */
+    static const unsigned char* ReadAsset(const char* name, int& size, unsigned char*& file_data);
+};
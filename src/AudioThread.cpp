@@ -0,0 +1,65 @@
+#include "AudioThread.hpp"
+#include <chrono>
+
+namespace {
+// Interval doplňování - výrazně kratší než délka bufferu streamu
+constexpr std::chrono::milliseconds REFILL_INTERVAL(5);
+}
+
+AudioThread::AudioThread(const unsigned char* music_data, int music_size, bool play_music)
+    : music_data(music_data), music_size(music_size), music_playing(play_music), running(true) {
+    worker = std::thread(&AudioThread::WorkerLoop, this);
+}
+
+AudioThread::~AudioThread() {
+    running = false;
+    worker.join();
+}
+
+void AudioThread::SetMusicEnabled(bool enabled) {
+    commands.Push({enabled ? AudioCommand::Type::PLAY_MUSIC : AudioCommand::Type::STOP_MUSIC, 0.0f});
+}
+
+void AudioThread::SetMusicVolume(float volume) {
+    commands.Push({AudioCommand::Type::SET_MUSIC_VOLUME, volume});
+}
+
+void AudioThread::WorkerLoop() {
+    // Otevření streamu a počáteční dekódování neblokuje herní smyčku
+    Music music = {};
+    if (music_data) music = LoadMusicStreamFromMemory(".ogg", music_data, music_size);
+    bool valid = IsMusicValid(music);
+    if (!valid) TraceLog(LOG_WARNING, "AUDIO: Failed to open music stream");
+    if (valid) ::SetMusicVolume(music, 1.0f);
+
+    while (running) {
+        AudioCommand command;
+        while (commands.Pop(command)) {
+            switch (command.type) {
+                case AudioCommand::Type::PLAY_MUSIC: music_playing = true; break;
+                case AudioCommand::Type::STOP_MUSIC: music_playing = false; break;
+                case AudioCommand::Type::SET_MUSIC_VOLUME:
+                    if (valid) ::SetMusicVolume(music, command.value);
+                    break;
+            }
+        }
+
+        if (valid) {
+            if (music_playing && !IsMusicStreamPlaying(music)) {
+                PlayMusicStream(music);
+            } else if (!music_playing && IsMusicStreamPlaying(music)) {
+                StopMusicStream(music);
+            }
+
+            // Dekódování a doplnění bufferu zařízení
+            if (IsMusicStreamPlaying(music)) UpdateMusicStream(music);
+        }
+
+        std::this_thread::sleep_for(REFILL_INTERVAL);
+    }
+
+    if (valid) {
+        StopMusicStream(music);
+        UnloadMusicStream(music);
+    }
+}
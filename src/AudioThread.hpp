@@ -0,0 +1,69 @@
+#pragma once
+
+#include "raylib.h"
+#include "SpscQueue.hpp"
+#include <atomic>
+#include <thread>
+
+/**
+ * Příkaz pro audio vlákno.
+ */
+struct AudioCommand {
+    enum class Type { PLAY_MUSIC, STOP_MUSIC, SET_MUSIC_VOLUME };
+    Type type;
+    float value;    // Hlasitost pro SET_MUSIC_VOLUME
+};
+
+/**
+ * Audio vlákno - vlastní hudební stream, dekóduje ho a doplňuje
+ * buffery zařízení nezávisle na herní smyčce. Dlouhý frame (velký
+ * výbuch) tak nezpůsobí podtečení bufferu a praskání.
+ *
+ * Herní vlákno posílá jen příkazy přes lock-free frontu, všechna
+ * volání hudebního API raylib probíhají výhradně v audio vlákně.
+ * Audio zařízení musí být inicializované (InitAudioDevice) po celou
+ * dobu života objektu.
+ */
+class AudioThread {
+public:
+    /**
+     * Konstruktor - spustí vlákno, které otevře hudební stream.
+     * @param music_data Zakódovaná hudba (OGG) v paměti - musí žít po celou dobu objektu
+     * @param music_size Velikost hudby v bajtech
+     * @param play_music Začít hrát hned po otevření
+     */
+    AudioThread(const unsigned char* music_data, int music_size, bool play_music);
+
+    /**
+     * Destruktor - zastaví hudbu, uvolní stream a ukončí vlákno.
+     */
+    ~AudioThread();
+
+    AudioThread(const AudioThread&) = delete;
+    AudioThread& operator=(const AudioThread&) = delete;
+
+    /**
+     * Zapne nebo vypne hudbu (přepínač v nastavení).
+     * @param enabled true = hrát
+     */
+    void SetMusicEnabled(bool enabled);
+
+    /**
+     * Nastaví hlasitost hudby.
+     * @param volume Hlasitost 0.0 - 1.0
+     */
+    void SetMusicVolume(float volume);
+
+private:
+    const unsigned char* music_data;        // Hudba v paměti (vlastní ji Assets)
+    int music_size;                         // Velikost hudby v bajtech
+    bool music_playing;                     // Hudba má hrát (jen audio vlákno)
+    SpscQueue<AudioCommand, 32> commands;   // Příkazy z herního vlákna
+    std::atomic<bool> running;              // Příznak běhu vlákna
+    std::thread worker;                     // Audio vlákno
+
+    /**
+     * Smyčka audio vlákna - příkazy a doplňování bufferu.
+     */
+    void WorkerLoop();
+};
@@ -2,26 +2,85 @@
 #include "Constants.hpp"
 #include "Utils.hpp"
 #include <algorithm>
-#include <deque>
+#include <atomic>
+#include <chrono>
 #include <cmath>
 
+namespace {
+// Nejdelší strana předrenderovaného pozadí v pixelech
+constexpr int MAX_BACKGROUND_SIZE = 2048;
+
+// Číslo další vytvořené desky
+std::atomic<unsigned int> next_id{1};
+
+// Efektových částic výbuchu může být naráz nejvýš tolik (kapacita se alokuje předem)
+constexpr size_t MAX_EXPLOSION_PARTICLES = 1024;
+
+// Nejvyšší počet kreslených efektových částic
+constexpr size_t MAX_DRAWN_EXPLOSION_PARTICLES = 301;
+}
+
 Board::Board() : width(BOARD_WIDTH * PARTICLES_PER_BLOCK), height(BOARD_HEIGHT * PARTICLES_PER_BLOCK),
-          shake_amount(0), shake_duration(0), dir_index(0),
-          grid_dirty(true),
-          explosion_state(ExplosionState::NONE), explosion_timer(0),
+          id(next_id++), rng(gen()), shake_rng(id), background_scale(1), overview_texture(), shake_amount(0), shake_duration(0), dir_index(0),
+          grid_dirty(true), landed_count(0), disturbance_cursor(0), change_version(1),
+          tick_deadline(std::chrono::steady_clock::time_point::max()),
+          explosion_state(ExplosionState::NONE), explosion_timer(0), explosion_scale(1.0f),
           explosion_flash_color(WHITE) {
     grid.resize(height, std::vector<Particle*>(width, nullptr));
+    row_versions.assign(height, change_version);
+
+    // Aréna částic - buňka desky a rezerva na jednu kostku přes obsazené buňky
+    // (AddParticles na ně zapisuje bez kontroly, mříž se pak přestaví)
+    size_t capacity = (size_t)width * height + 4 * PARTICLES_PER_BLOCK * PARTICLES_PER_BLOCK;
+    particle_pool.assign(capacity, Particle(0, 0, BLANK));
+    free_particles.reserve(capacity);
+    for (size_t i = capacity; i-- > 0;) free_particles.push_back(&particle_pool[i]);
+    explode_marks.assign(capacity, 0);
+
+    // Pracovní seznamy na nejhorší případ - celá deska
+    particles.reserve(capacity);
+    unsettled_particles.reserve(capacity);
+    gravity_batch.reserve(capacity);
+    particles_to_explode.reserve(capacity);
+    pending_disturbances.reserve(capacity);
+    disturbance_distance.reserve(capacity);
+    disturbance_cells.reserve(capacity);
+    component_visited.resize(width * height, 0);
+    component_cells.reserve(width * height);
+    explosion_particles.reserve(MAX_EXPLOSION_PARTICLES);
+
+    // Události a skupiny jsou malé - jedna událost na druh, skupina na barvu
+    change_events.reserve(8);
+    connection_regions.reserve(8);
+    exploding_groups.reserve(PALETTE_SIZE * 4);
     CreateBackground();
 }
 
 Board::~Board() {
     UnloadRenderTexture(background_texture);
-    for (auto p : particles) delete p;
+    if (overview_texture.id != 0) UnloadTexture(overview_texture);
+}
+
+Particle* Board::AllocateParticle(const Particle& source) {
+    if (free_particles.empty()) return nullptr;
+    Particle* particle = free_particles.back();
+    free_particles.pop_back();
+    *particle = source;
+    return particle;
+}
+
+void Board::ReleaseParticle(Particle* particle) {
+    explode_marks[particle - particle_pool.data()] = 0;
+    free_particles.push_back(particle);
 }
 
 void Board::CreateBackground() {
-    int board_width_px = width * PARTICLE_SIZE;
-    int board_height_px = height * PARTICLE_SIZE;
+    // Velká deska dostane texturu s menším počtem pixelů na částici,
+    // aby nepřekročila MAX_BACKGROUND_SIZE (kreslí se roztažená)
+    background_scale = std::clamp(MAX_BACKGROUND_SIZE / std::max(width, height), 1, PARTICLE_SIZE);
+    int board_width_px = width * background_scale;
+    int board_height_px = height * background_scale;
+    int cell_px = PARTICLES_PER_BLOCK * background_scale;
     background_texture = LoadRenderTexture(board_width_px, board_height_px);
 
     BeginTextureMode(background_texture);
@@ -39,23 +98,37 @@ void Board::CreateBackground() {
     }
 
     Color grid_color = {40, 40, 55, 255};
-    for (int i = 0; i <= BOARD_WIDTH; i++) {
+    for (int i = 0; i <= width / PARTICLES_PER_BLOCK; i++) {
         Color gc = (i % 2 == 0) ? Color{50, 50, 65, 255} : Color{40, 40, 55, 255};
-        DrawLine(i * CELL_SIZE, 0, i * CELL_SIZE, board_height_px, gc);
+        DrawLine(i * cell_px, 0, i * cell_px, board_height_px, gc);
     }
-    for (int i = 0; i <= BOARD_HEIGHT; i++) {
-        DrawLine(0, i * CELL_SIZE, board_width_px, i * CELL_SIZE, grid_color);
+    for (int i = 0; i <= height / PARTICLES_PER_BLOCK; i++) {
+        DrawLine(0, i * cell_px, board_width_px, i * cell_px, grid_color);
     }
 
     EndTextureMode();
 }
 
 void Board::AddParticles(const std::vector<Particle>& new_particles) {
+    int min_x = width, min_y = height, max_x = -1, max_y = -1;
     for (const auto& p : new_particles) {
         if (p.y >= 0 && p.y < height && p.x >= 0 && p.x < width) {
-            particles.push_back(new Particle(p));
+            Particle* particle = AllocateParticle(p);
+            if (!particle) break;
+            particles.push_back(particle);
+            // Zapsat rovnou do mříže, přestavba celé mříže není potřeba
+            Particle*& cell = grid[(int)p.y][(int)p.x];
+            if (cell == nullptr) cell = particle;
+            else grid_dirty = true;
+            if (!particle->settled) unsettled_particles.push_back(particle);
+            MarkRowDirty((int)p.y);
+            min_x = std::min(min_x, (int)p.x);
+            min_y = std::min(min_y, (int)p.y);
+            max_x = std::max(max_x, (int)p.x);
+            max_y = std::max(max_y, (int)p.y);
         }
     }
+    if (max_x >= 0) AddChangeEvent(BoardEventType::PIECE_LOCKED, min_x, min_y, max_x, max_y);
 }
 
 void Board::TriggerShake(int intensity) {
@@ -80,7 +153,8 @@ void Board::UpdateShake() {
 Vector2 Board::GetShakeOffset() {
     if (shake_amount > 0) {
         std::uniform_int_distribution<> shake_dist(-shake_amount, shake_amount);
-        return {(float)shake_dist(gen), (float)shake_dist(gen)};
+        // Vlastní generátor - počet vykreslených snímků nesmí měnit průběh simulace
+        return {(float)shake_dist(shake_rng), (float)shake_dist(shake_rng)};
     }
     return {0, 0};
 }
@@ -96,77 +170,109 @@ bool Board::CheckCollision(const std::vector<Particle>& test_particles) {
     return false;
 }
 
+void Board::MarkAllRowsDirty() {
+    change_version++;
+    std::fill(row_versions.begin(), row_versions.end(), change_version);
+}
+
+void Board::AddChangeEvent(BoardEventType type, int min_x, int min_y, int max_x, int max_y) {
+    for (auto& event : change_events) {
+        if (event.type != type) continue;
+        event.min_x = std::min(event.min_x, min_x);
+        event.min_y = std::min(event.min_y, min_y);
+        event.max_x = std::max(event.max_x, max_x);
+        event.max_y = std::max(event.max_y, max_y);
+        return;
+    }
+    change_events.push_back({type, min_x, min_y, max_x, max_y});
+}
+
 void Board::RebuildGrid() {
     for (auto& row : grid) {
         std::fill(row.begin(), row.end(), nullptr);
     }
 
+    unsettled_particles.clear();
     for (auto p : particles) {
         int px = (int)p->x;
         int py = (int)p->y;
         if (py >= 0 && py < height && px >= 0 && px < width) {
             grid[py][px] = p;
         }
+        if (!p->settled) unsettled_particles.push_back(p);
     }
     grid_dirty = false;
 }
 
-bool Board::AreAllParticlesSettled() {
-    for (auto p : particles) {
-        if (!p->settled) {
-            return false;
-        }
+void Board::WakeParticle(Particle* particle) {
+    if (!particle->settled) return;
+    particle->settled = false;
+    unsettled_particles.push_back(particle);
+    MarkRowDirty((int)particle->y);
+}
+
+void Board::WakeColumnAbove(int x, int y) {
+    if (x < 0 || x >= width || y <= 0 || y > height) return;
+
+    // Souvislý sloupec nad buňkou stál na uvolněné částici; nad mezerou nebo
+    // padající částicí už je sloupec vzhůru a probudí se, až se pohne
+    for (int wy = y - 1; wy >= 0; wy--) {
+        Particle* p = grid[wy][x];
+        if (p == nullptr || !p->settled) break;
+        WakeParticle(p);
     }
-    return true;
+}
+
+void Board::BeginTick() {
+    tick_deadline = SIM_BUDGET_US > 0
+        ? std::chrono::steady_clock::now() + std::chrono::microseconds(SIM_BUDGET_US)
+        : std::chrono::steady_clock::time_point::max();
+}
+
+bool Board::HasTickBudget() const {
+    return std::chrono::steady_clock::now() < tick_deadline;
 }
 
 void Board::ApplyGravity() {
     // Pokud je mřížka dirty, rebuild ji
     if (grid_dirty) RebuildGrid();
+    landed_count = 0;
 
-    // Rychlá kontrola - pokud nejsou žádné neusazené částice, konec
-    bool has_unsettled = false;
-    for (auto p : particles) {
-        if (!p->settled) {
-            has_unsettled = true;
-            break;
-        }
-    }
-    if (!has_unsettled) return;
-
-    // Kontrola usazených částic - pokud pod nimi není nic, stanou se neusazenými
-    for (auto p : particles) {
-        int px = (int)p->x;
-        int py = (int)p->y;
-        if (p->settled && py >= 0 && py + 1 < height && px >= 0 && px < width) {
-            if (grid[py + 1][px] == nullptr) {
-                p->settled = false;
-            }
-        }
-    }
+    // Padající částice mají přednost, otřes po výbuchu dostane zbytek rozpočtu
+    MoveUnsettledParticles();
+    ApplyDisturbances();
+}
 
-    // Sesbírat všechny neusazené částice
-    std::vector<Particle*> unsettled;
-    unsettled.reserve(particles.size() / 4); // Předalokace
-    for (auto p : particles) {
-        if (!p->settled) {
-            unsettled.push_back(p);
-        }
+void Board::MoveUnsettledParticles() {
+    // Rychlá kontrola - pokud nejsou žádné neusazené částice, konec
+    if (unsettled_particles.empty()) return;
+
+    // Převzít neusazené částice; probuzené během ticku přibydou do prázdného seznamu
+    gravity_batch.swap(unsettled_particles);
+    unsettled_particles.clear();
+
+    // Limit pro výkon - max 1000 částic na frame (zbytek počká na další tick)
+    if (gravity_batch.size() > 1000) {
+        std::nth_element(gravity_batch.begin(), gravity_batch.begin() + 1000, gravity_batch.end(),
+                         [](Particle* a, Particle* b) { return a->y > b->y; });
+        unsettled_particles.insert(unsettled_particles.end(), gravity_batch.begin() + 1000, gravity_batch.end());
+        gravity_batch.resize(1000);
     }
 
-    // Limit pro výkon - max 1000 částic na frame
-    if (unsettled.size() > 1000) unsettled.resize(1000);
-
     // Seřadit podle Y (zdola nahoru) pro správné usazování
-    std::sort(unsettled.begin(), unsettled.end(),
+    std::sort(gravity_batch.begin(), gravity_batch.end(),
               [](Particle* a, Particle* b) { return a->y > b->y; });
 
     // Směry pro diagonální pohyb (alternování pro rovnoměrné rozprostření)
     dir_index = (dir_index + 1) % 2;
     int diagonal_dirs[][2] = {{-1, 1}, {1, -1}};
 
-    // Aplikuj gravitaci na každou neusazenou částici
-    for (auto particle : unsettled) {
+    // Aplikuj gravitaci na každou neusazenou částici, dokud zbývá rozpočet ticku;
+    // nezpracované (výš položené) zůstanou neusazené a přijdou na řadu příště
+    constexpr size_t BUDGET_CHECK_INTERVAL = 64;
+    for (size_t i = 0; i < gravity_batch.size(); i++) {
+        if (i > 0 && i % BUDGET_CHECK_INTERVAL == 0 && !HasTickBudget()) break;
+        Particle* particle = gravity_batch[i];
         int old_x = (int)particle->x;
         int old_y = (int)particle->y;
         bool moved = false;
@@ -194,6 +300,7 @@ void Board::ApplyGravity() {
         if (new_y > old_y) {
             particle->y = new_y;
             if (new_y >= height - 1) {
+                if (particle->velocity_y >= LANDING_VELOCITY) landed_count++;
                 particle->settled = true;
                 particle->velocity_y = 0;
                 particle->y = height - 1;
@@ -205,6 +312,7 @@ void Board::ApplyGravity() {
         }
         // Pokud je na dně desky
         else if (old_y + 1 >= height) {
+            if (particle->velocity_y >= LANDING_VELOCITY) landed_count++;
             particle->settled = true;
             particle->velocity_y = 0;
             particle->y = height - 1;
@@ -213,6 +321,7 @@ void Board::ApplyGravity() {
         }
         // Pokus o diagonální pohyb (jako písek)
         else {
+            if (particle->velocity_y >= LANDING_VELOCITY) landed_count++;
             particle->velocity_y = 0;
             int test_y = old_y + 1;
 
@@ -229,100 +338,135 @@ void Board::ApplyGravity() {
             }
         }
 
-        // Pokud se částice nepohnula, usadit ji
+        // Změna pozice nebo usazení mění oba dotčené řádky
+        MarkRowDirty(old_y);
+        MarkRowDirty((int)particle->y);
+
+        // Pokud se částice nepohnula, usadit ji - jen má-li oporu (po odrazu nahoru
+        // pod ní může být volno, pak padá v dalším ticku)
         if (!moved) {
-            particle->settled = true;
+            particle->settled = old_y + 1 >= height || grid[old_y + 1][old_x] != nullptr;
             particle->velocity_y = 0;
             if (old_y >= 0 && old_y < height && old_x >= 0 && old_x < width) {
                 grid[old_y][old_x] = particle;
             }
         }
+        // Uvolněná buňka může vzít oporu částicím nad ní
+        else if ((int)particle->x != old_x || (int)particle->y != old_y) {
+            WakeColumnAbove(old_x, old_y);
+        }
     }
-}
 
-std::set<Particle*> Board::FindConnectedGroup(Particle* start) {
-    // BFS algoritmus pro nalezení všech propojených částic stejné barvy
-    std::set<Particle*> visited;
-    std::deque<Particle*> queue;
-    queue.push_back(start);
-    visited.insert(start);
-    Color target_color = start->color;
-
-    // Směry pro kontrolu sousedů (nahoru, dolů, vlevo, vpravo)
-    constexpr int dirs[][2] = {{0, 1}, {0, -1}, {1, 0}, {-1, 0}};
-
-    while (!queue.empty()) {
-        Particle* current = queue.front();
-        queue.pop_front();
-
-        int cx = (int)current->x;
-        int cy = (int)current->y;
-
-        // Zkontroluj všechny 4 sousedy
-        for (auto& dir : dirs) {
-            int nx = cx + dir[0];
-            int ny = cy + dir[1];
-
-            // Validace pozice a kontrola, jestli už nebyl navštíven
-            if (nx >= 0 && nx < width && ny >= 0 && ny < height &&
-                grid[ny][nx] != nullptr && visited.find(grid[ny][nx]) == visited.end()) {
-                Particle* neighbor = grid[ny][nx];
-                // Porovnání barvy (RGB komponenty)
-                if (neighbor->color.r == target_color.r &&
-                    neighbor->color.g == target_color.g &&
-                    neighbor->color.b == target_color.b) {
-                    visited.insert(neighbor);
-                    queue.push_back(neighbor);
-                }
-            }
+    // Usazené částice mohly vytvořit nové spojení - jedna změna za tick
+    int min_x = width, min_y = height, max_x = -1, max_y = -1;
+    for (auto particle : gravity_batch) {
+        if (!particle->settled) {
+            unsettled_particles.push_back(particle);
+            continue;
         }
+        min_x = std::min(min_x, (int)particle->x);
+        min_y = std::min(min_y, (int)particle->y);
+        max_x = std::max(max_x, (int)particle->x);
+        max_y = std::max(max_y, (int)particle->y);
     }
+    if (max_x >= 0) AddChangeEvent(BoardEventType::REGION_SETTLED, min_x, min_y, max_x, max_y);
+}
 
-    return visited;
+namespace {
+// Porovnání barvy (RGB komponenty)
+bool SameColor(const Particle* a, const Particle* b) {
+    return a->color.r == b->color.r && a->color.g == b->color.g && a->color.b == b->color.b;
+}
 }
 
 int Board::CheckHorizontalConnections() {
     // Pokud probíhá výbuch, neprovádět další kontroly
     if (explosion_state != ExplosionState::NONE) return 0;
 
-    int removed_count = 0;
+    // Po vyčerpání rozpočtu ticku se kontrola odloží (změny zůstanou čekat);
+    // na klidné desce proběhne vždy
+    if (!HasTickBudget() && !unsettled_particles.empty()) return 0;
 
-    // Projít všechny řádky a hledat skupiny, které dosahují od levé po pravou stranu
-    for (int y = 0; y < height; y++) {
-        if (grid[y][0] == nullptr) continue;
-
-        // Najít všechny propojené částice stejné barvy od levého okraje
-        Particle* start_particle = grid[y][0];
-        auto connected_group = FindConnectedGroup(start_particle);
-
-        // Zkontrolovat, jestli skupina dosahuje pravého okraje
-        bool reaches_right = false;
-        for (auto p : connected_group) {
-            if ((int)p->x == width - 1) {
-                reaches_right = true;
-                break;
+    // Nové spojení musí vést přes přidanou nebo usazenou částici - jen jejich
+    // oblasti jsou semínka hledání; odebrání částic spojení nevytvoří
+    connection_regions.clear();
+    for (const auto& event : change_events) {
+        if (event.type != BoardEventType::GRAINS_REMOVED) connection_regions.push_back(event);
+    }
+    change_events.clear();
+    if (connection_regions.empty()) return 0;
+
+    // Spojení potřebuje obsazený levý i pravý sloupec
+    bool touches_left = false, touches_right = false;
+    for (int y = 0; y < height && !(touches_left && touches_right); y++) {
+        touches_left = touches_left || grid[y][0] != nullptr;
+        touches_right = touches_right || grid[y][width - 1] != nullptr;
+    }
+    if (!touches_left || !touches_right) return 0;
+
+    exploding_groups.clear();
+    particles_to_explode.clear();
+    explosion_scale = 1.0f;
+    component_cells.clear();
+
+    // Flood fill (4-okolí) každé stejnobarevné skupiny zasahující do změněných
+    // oblastí; projde se jen jejich okolí, ne celá deska
+    for (const auto& region : connection_regions) {
+        for (int sy = std::max(0, region.min_y); sy <= std::min(height - 1, region.max_y); sy++) {
+            for (int sx = std::max(0, region.min_x); sx <= std::min(width - 1, region.max_x); sx++) {
+                if (grid[sy][sx] == nullptr || component_visited[sy * width + sx]) continue;
+
+                size_t first = component_cells.size();
+                bool left = false, right = false;
+                component_visited[sy * width + sx] = 1;
+                component_cells.push_back(sy * width + sx);
+                for (size_t next = first; next < component_cells.size(); next++) {
+                    int x = component_cells[next] % width;
+                    int y = component_cells[next] / width;
+                    Particle* p = grid[y][x];
+                    left = left || x == 0;
+                    right = right || x == width - 1;
+
+                    constexpr int dirs[][2] = {{0, 1}, {0, -1}, {1, 0}, {-1, 0}};
+                    for (auto& dir : dirs) {
+                        int nx = x + dir[0];
+                        int ny = y + dir[1];
+                        if (nx < 0 || nx >= width || ny < 0 || ny >= height) continue;
+                        int n = ny * width + nx;
+                        if (!component_visited[n] && grid[ny][nx] != nullptr && SameColor(p, grid[ny][nx])) {
+                            component_visited[n] = 1;
+                            component_cells.push_back(n);
+                        }
+                    }
+                }
+                if (!left || !right) continue;
+
+                // Skupina spojuje okraje - všechny takové vybuchnou najednou
+                ExplosionGroup group = {grid[sy][sx]->color, (int)(component_cells.size() - first)};
+                for (size_t c = first; c < component_cells.size(); c++) {
+                    Particle* particle = grid[component_cells[c] / width][component_cells[c] % width];
+                    particles_to_explode.push_back(particle);
+                    explode_marks[particle - particle_pool.data()] = 1;
+                }
+                exploding_groups.push_back(group);
             }
         }
+    }
 
-        // Pokud skupina spojuje levou a pravou stranu, spustit výbuch
-        if (reaches_right) {
-            explosion_state = ExplosionState::ZOOMING;
-            explosion_timer = 0;
-            particles_to_explode = connected_group;
-            particle_scale_factors.clear();
-
-            // Inicializovat škálovací faktory pro zoom animaci
-            for (auto particle : connected_group) {
-                particle_scale_factors[particle] = 1.0f;
-            }
+    // Pracovní značky vynulovat jen tam, kudy hledání prošlo
+    for (int cell : component_cells) component_visited[cell] = 0;
+    if (exploding_groups.empty()) return 0;
 
-            explosion_flash_color = start_particle->color;
-            removed_count = connected_group.size();
-            break; // Pouze jeden výbuch najednou
-        }
+    // Blesk má barvu největší skupiny
+    const ExplosionGroup* largest = &exploding_groups[0];
+    for (const auto& group : exploding_groups) {
+        if (group.grains > largest->grains) largest = &group;
     }
+    explosion_flash_color = largest->color;
+    explosion_state = ExplosionState::ZOOMING;
+    explosion_timer = 0;
 
-    return removed_count;
+    return (int)particles_to_explode.size();
 }
 
 void Board::UpdatePreExplosionAnimation() {
@@ -342,9 +486,7 @@ void Board::UpdatePreExplosionAnimation() {
             float pulse = sinf((float)explosion_timer * 0.3f) * 0.05f; // Pulsace
 
             // Aplikovat škálování na všechny částice určené k výbuchu
-            for (auto& pair : particle_scale_factors) {
-                pair.second = 1.0f + (MAX_SCALE - 1.0f) * eased + pulse;
-            }
+            explosion_scale = 1.0f + (MAX_SCALE - 1.0f) * eased + pulse;
 
             // Třesení obrazovky stoupající s progressem
             if (explosion_timer % 3 == 0) {
@@ -367,9 +509,11 @@ void Board::UpdatePreExplosionAnimation() {
             for (auto particle : particles_to_explode) {
                 if (i % sample_step == 0) {
                     std::uniform_int_distribution<> exp_count(3, 6);
-                    int num_explosions = exp_count(gen);
+                    int num_explosions = exp_count(rng);
                     for (int j = 0; j < num_explosions; j++) {
-                        explosion_particles.emplace_back((int)particle->x, (int)particle->y, particle->color);
+                        // Plná předem alokovaná kapacita - další efekt se vynechá
+                        if (explosion_particles.size() == MAX_EXPLOSION_PARTICLES) break;
+                        explosion_particles.emplace_back((int)particle->x, (int)particle->y, particle->color, rng);
                     }
                 }
                 i++;
@@ -378,49 +522,120 @@ void Board::UpdatePreExplosionAnimation() {
     }
     // FÁZE 2: Odstranění částic po výbuchu
     else if (explosion_state == ExplosionState::EXPLODING) {
-        if (explosion_timer > 5) {
-            // Smazat všechny vybuchlé částice
-            for (auto particle : particles_to_explode) {
-                auto it = std::find(particles.begin(), particles.end(), particle);
-                if (it != particles.end()) {
-                    delete *it;
-                    particles.erase(it);
-                }
-            }
-
-            // Simulace otřesu desky - přidáme částicím malé náhodné posunutí
-            std::uniform_int_distribution<> shake_dist(-10, 10);
-            std::uniform_real_distribution<> vertical_shake(0.0f, 20.0f);
-
-            for (auto p : particles) {
-                // Horizontální posunutí (vlevo/vpravo)
-                int dx = shake_dist(gen);
-                int new_x = (int)p->x + dx;
-
-                // Vertikální "vyhození" nahoru (simulace odrazu od země)
-                float vertical_impulse = vertical_shake(gen);
-                p->velocity_y = -(int)vertical_impulse; // Záporná rychlost = pohyb nahoru
-
-                // Aplikuj horizontální posunutí pokud je validní
-                if (new_x >= 0 && new_x < width) {
-                    // Zkontroluj jestli není kolize
-                    int py = (int)p->y;
-                    if (py >= 0 && py < height && grid[py][new_x] == nullptr) {
-                        p->x = new_x;
+        // Úklid výbuchu je drahý - po vyčerpání rozpočtu počká na další tick
+        // (na klidné desce proběhne vždy, aby se nikdy neodkládal donekonečna)
+        if (explosion_timer > 5 && (HasTickBudget() || unsettled_particles.empty())) {
+            // Smazat všechny vybuchlé částice (jeden průchod i pro víc skupin);
+            // uvolněné buňky jsou zdroji otřesu
+            int min_x = width, min_y = height, max_x = -1, max_y = -1;
+            disturbance_distance.assign(width * height, -1);
+            disturbance_cells.clear();
+            particles.erase(
+                std::remove_if(particles.begin(), particles.end(), [&](Particle* particle) {
+                    if (!explode_marks[particle - particle_pool.data()]) return false;
+                    int px = (int)particle->x;
+                    int py = (int)particle->y;
+                    MarkRowDirty(py);
+                    min_x = std::min(min_x, px);
+                    min_y = std::min(min_y, py);
+                    max_x = std::max(max_x, px);
+                    max_y = std::max(max_y, py);
+                    if (py >= 0 && py < height && px >= 0 && px < width) {
+                        if (grid[py][px] == particle) grid[py][px] = nullptr;
+                        disturbance_distance[py * width + px] = 0;
+                        disturbance_cells.push_back(py * width + px);
                     }
-                }
+                    ReleaseParticle(particle);
+                    return true;
+                }),
+                particles.end()
+            );
+            if (max_x >= 0) AddChangeEvent(BoardEventType::GRAINS_REMOVED, min_x, min_y, max_x, max_y);
 
-                // Všechny částice se stávají neusazenými (gravitace je znovu aplikuje)
-                p->settled = false;
-            }
+            // Sloupce nad dírami ztratily oporu - padají hned, bez ohledu na rozpočet
+            for (int cell : disturbance_cells) WakeColumnAbove(cell % width, cell / width);
+
+            QueueDisturbances();
 
             // Cleanup a reset stavu výbuchu
             particles_to_explode.clear();
-            particle_scale_factors.clear();
+            explosion_scale = 1.0f;
+            exploding_groups.clear();
             explosion_state = ExplosionState::NONE;
+        }
+    }
+}
 
-            RebuildGrid();
+void Board::QueueDisturbances() {
+    // Vzdálenost od nejbližší vybuchlé buňky (8-okolí) do DISTURBANCE_RADIUS;
+    // BFS prochází jen okolí výbuchu a řadí částice od nejbližší
+    for (size_t head = 0; head < disturbance_cells.size(); head++) {
+        int cell = disturbance_cells[head];
+        int x = cell % width;
+        int y = cell / width;
+        int distance = disturbance_distance[cell];
+
+        if (distance > 0 && grid[y][x] != nullptr) {
+            float strength = 1.0f - (float)distance / (DISTURBANCE_RADIUS + 1);
+            pending_disturbances.push_back({x, y, strength});
         }
+        if (distance == DISTURBANCE_RADIUS) continue;
+
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                int nx = x + dx;
+                int ny = y + dy;
+                if (nx < 0 || nx >= width || ny < 0 || ny >= height) continue;
+                int next = ny * width + nx;
+                if (disturbance_distance[next] >= 0) continue;
+                disturbance_distance[next] = distance + 1;
+                disturbance_cells.push_back(next);
+            }
+        }
+    }
+}
+
+void Board::ApplyDisturbances() {
+    if (pending_disturbances.empty()) return;
+
+    // Simulace otřesu desky - částicím v okolí výbuchu malé náhodné posunutí
+    // a odraz nahoru, obojí slábne se vzdáleností
+    std::uniform_int_distribution<> shake_dist(-10, 10);
+    std::uniform_real_distribution<> vertical_shake(0.0f, 20.0f);
+
+    // Rozpočet ticku se kontroluje po dávkách, aspoň jedna dávka vždy proběhne
+    constexpr size_t BATCH = 32;
+
+    while (disturbance_cursor < pending_disturbances.size()) {
+        size_t batch_end = std::min(disturbance_cursor + BATCH, pending_disturbances.size());
+        for (; disturbance_cursor < batch_end; disturbance_cursor++) {
+            const Disturbance& disturbance = pending_disturbances[disturbance_cursor];
+            Particle* p = grid[disturbance.y][disturbance.x];
+            if (p == nullptr) continue;
+
+            // Horizontální posunutí (vlevo/vpravo)
+            int new_x = disturbance.x + (int)std::lround(shake_dist(rng) * disturbance.strength);
+
+            // Vertikální "vyhození" nahoru (simulace odrazu od země)
+            float vertical_impulse = vertical_shake(rng) * disturbance.strength;
+            p->velocity_y = -(int)vertical_impulse; // Záporná rychlost = pohyb nahoru
+            WakeParticle(p);
+
+            // Aplikuj horizontální posunutí pokud je validní a bez kolize
+            if (new_x != disturbance.x && new_x >= 0 && new_x < width &&
+                grid[disturbance.y][new_x] == nullptr) {
+                grid[disturbance.y][disturbance.x] = nullptr;
+                grid[disturbance.y][new_x] = p;
+                p->x = new_x;
+                WakeColumnAbove(disturbance.x, disturbance.y);
+            }
+        }
+        if (!HasTickBudget()) break;
+    }
+
+    if (disturbance_cursor == pending_disturbances.size()) {
+        pending_disturbances.clear();
+        disturbance_cursor = 0;
     }
 }
 
@@ -436,37 +651,130 @@ void Board::UpdateExplosions() {
     );
 }
 
-void Board::Draw(int offset_x, int offset_y) {
-    DrawTextureRec(background_texture.texture,
-                  {0, 0, (float)width * PARTICLE_SIZE, -(float)height * PARTICLE_SIZE},
-                  {(float)offset_x, (float)offset_y}, WHITE);
+void Board::CaptureFrame(BoardFrame& frame) {
+    if (grid_dirty) RebuildGrid();
+
+    // Snímek jiné desky (nebo první) se zachytí celý
+    if (frame.board_id != id || frame.width != width || frame.height != height) {
+        frame.board_id = id;
+        frame.width = width;
+        frame.height = height;
+        frame.cells.assign(width * height, BLANK);
+        frame.row_versions.assign(height, 0);
+        // Kapacita na nejhorší případ - další snímky do slotu nealokují
+        frame.exploding.reserve(width * height);
+        frame.explosion_particles.reserve(MAX_DRAWN_EXPLOSION_PARTICLES);
+    }
+
+    // Kopírovat jen řádky změněné od minulého snímku v tomto slotu
+    for (int y = 0; y < height; y++) {
+        if (frame.row_versions[y] == row_versions[y]) continue;
+        frame.row_versions[y] = row_versions[y];
+        Color* row = &frame.cells[y * width];
+        for (int x = 0; x < width; x++) {
+            row[x] = grid[y][x] ? grid[y][x]->color : BLANK;
+        }
+    }
+    frame.particle_count = (int)particles.size();
+
+    frame.exploding.clear();
+    frame.explosion_scale = explosion_scale;
+    for (auto particle : particles_to_explode) frame.exploding.push_back(*particle);
+
+    // Kreslí se jen omezený počet efektových částic
+    size_t explosion_count = std::min(explosion_particles.size(), MAX_DRAWN_EXPLOSION_PARTICLES);
+    frame.explosion_particles.assign(explosion_particles.begin(), explosion_particles.begin() + explosion_count);
+
+    frame.flash = explosion_flash_color;
+    frame.flash.a = 0;
+    if (explosion_state == ExplosionState::EXPLODING && explosion_timer < 10) {
+        float flash_alpha = (1.0f - (float)explosion_timer / 10.0f) * 0.3f;
+        frame.flash.a = (unsigned char)(255 * flash_alpha);
+    }
+
+    frame.shake = GetShakeOffset();
+}
+
+void Board::DrawBackground(int offset_x, int offset_y) const {
+    DrawTexturePro(background_texture.texture,
+                  {0, 0, (float)background_texture.texture.width, -(float)background_texture.texture.height},
+                  {(float)offset_x, (float)offset_y, (float)width * PARTICLE_SIZE, (float)height * PARTICLE_SIZE},
+                  {0, 0}, 0.0f, WHITE);
 
     DrawRectangleLines(offset_x - 2, offset_y - 2,
                       width * PARTICLE_SIZE + 4, height * PARTICLE_SIZE + 4,
                       Color{80, 80, 120, 255});
+}
 
-    for (auto p : particles) {
-        bool is_exploding = false;
-        float scale = 1.0f;
+void Board::DrawEffects(const BoardFrame& frame, Rectangle view, int offset_x, int offset_y) const {
+    if (frame.flash.a > 0) {
+        DrawRectangle(offset_x, offset_y, width * PARTICLE_SIZE, height * PARTICLE_SIZE, frame.flash);
+    }
+
+    // Efektové částice mimo pohled se přeskočí (okraj na poloměr kruhu)
+    for (auto& e : frame.explosion_particles) {
+        if (e.x < view.x - 1 || e.x > view.x + view.width + 1 ||
+            e.y < view.y - 1 || e.y > view.y + view.height + 1) continue;
+        e.Draw(offset_x, offset_y);
+    }
+}
 
-        if (particle_scale_factors.find(p) != particle_scale_factors.end()) {
-            scale = particle_scale_factors[p];
-            is_exploding = true;
+void Board::Draw(const BoardFrame& frame, Rectangle view, int offset_x, int offset_y) const {
+    DrawBackground(offset_x, offset_y);
+    if (frame.board_id != id) return;
+
+    // Jen buňky v pohledu
+    int min_x = std::max(0, (int)view.x);
+    int min_y = std::max(0, (int)view.y);
+    int max_x = std::min(width - 1, (int)(view.x + view.width));
+    int max_y = std::min(height - 1, (int)(view.y + view.height));
+    for (int y = min_y; y <= max_y; y++) {
+        const Color* row = &frame.cells[y * width];
+        for (int x = min_x; x <= max_x; x++) {
+            if (row[x].a == 0) continue;
+            Particle((float)x, (float)y, row[x]).Draw(offset_x, offset_y);
         }
+    }
 
-        p->Draw(offset_x, offset_y, is_exploding, scale);
+    // Částice před výbuchem se kreslí zvětšené přes své buňky
+    for (auto& p : frame.exploding) {
+        if (p.x < min_x - 1 || p.x > max_x + 1 || p.y < min_y - 1 || p.y > max_y + 1) continue;
+        p.Draw(offset_x, offset_y, true, frame.explosion_scale);
     }
 
-    if (explosion_state == ExplosionState::EXPLODING && explosion_timer < 10) {
-        float flash_alpha = (1.0f - (float)explosion_timer / 10.0f) * 0.3f;
-        Color flash = explosion_flash_color;
-        flash.a = (unsigned char)(255 * flash_alpha);
-        DrawRectangle(offset_x, offset_y, width * PARTICLE_SIZE, height * PARTICLE_SIZE, flash);
+    DrawEffects(frame, view, offset_x, offset_y);
+}
+
+void Board::DrawOverview(const BoardFrame& frame, int offset_x, int offset_y) {
+    DrawBackground(offset_x, offset_y);
+    if (frame.board_id != id) return;
+
+    if (overview_texture.id == 0) {
+        Image image = GenImageColor(width, height, BLANK);
+        overview_texture = LoadTextureFromImage(image);
+        UnloadImage(image);
+        SetTextureFilter(overview_texture, TEXTURE_FILTER_BILINEAR);
+        overview_row_versions.assign(height, 0);
     }
 
-    int explosion_count = 0;
-    for (auto& e : explosion_particles) {
-        if (explosion_count++ > 300) break;
-        e.Draw(offset_x, offset_y);
+    // Nahrát změněné řádky, souvislé úseky jedním voláním
+    for (int y = 0; y < height;) {
+        if (overview_row_versions[y] == frame.row_versions[y]) {
+            y++;
+            continue;
+        }
+        int first = y;
+        while (y < height && overview_row_versions[y] != frame.row_versions[y]) {
+            overview_row_versions[y] = frame.row_versions[y];
+            y++;
+        }
+        UpdateTextureRec(overview_texture, {0, (float)first, (float)width, (float)(y - first)},
+                         &frame.cells[first * width]);
     }
+
+    DrawTexturePro(overview_texture, {0, 0, (float)width, (float)height},
+                  {(float)offset_x, (float)offset_y, (float)width * PARTICLE_SIZE, (float)height * PARTICLE_SIZE},
+                  {0, 0}, 0.0f, WHITE);
+
+    DrawEffects(frame, {0, 0, (float)width, (float)height}, offset_x, offset_y);
 }
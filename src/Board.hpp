@@ -4,13 +4,68 @@
 #include "Particle.hpp"
 #include "ExplosionParticle.hpp"
 #include <vector>
-#include <set>
-#include <unordered_map>
+#include <chrono>
+#include <cstddef>
+#include <random>
+
+/**
+ * Neměnný snímek desky pro vykreslení - kopie všeho, co Board::Draw potřebuje.
+ * Může vzniknout na vlákně simulace a kreslit se na hlavním vlákně.
+ * Buňky se kopírují jen v řádcích, které se od minulého snímku v tomto
+ * slotu změnily, takže cena zachycení nezávisí na velikosti desky.
+ */
+struct BoardFrame {
+    unsigned int board_id = 0;                           // Deska, ze které snímek vznikl (0 = žádná)
+    int width = 0, height = 0;                           // Rozměry desky v buňkách částic
+    std::vector<Color> cells;                            // Barvy buněk po řádcích (alpha 0 = prázdná)
+    std::vector<unsigned int> row_versions;              // Verze řádků v cells (viz Board::row_versions)
+    int particle_count = 0;                              // Počet částic desky
+    std::vector<Particle> exploding;                     // Částice určené k výbuchu (kreslí se zvětšené)
+    float explosion_scale;                               // Zoom částic před výbuchem
+    std::vector<ExplosionParticle> explosion_particles;  // Vykreslované efektové částice
+    Color flash;                                         // Záblesk výbuchu (alpha 0 = žádný)
+    Vector2 shake;                                       // Posun třesení obrazovky
+};
+
+/**
+ * Druhy změn desky.
+ */
+enum class BoardEventType {
+    PIECE_LOCKED,       // Kostka se přidala na desku
+    REGION_SETTLED,     // Částice se usadily
+    GRAINS_REMOVED,     // Částice zmizely (výbuch)
+    BOARD_RESET,        // Celá deska se nahradila (načtení, přetočení, divák)
+    COUNT
+};
+
+/**
+ * Změna desky s obdélníkem dotčených buněk (včetně krajních).
+ */
+struct BoardEvent {
+    BoardEventType type;
+    int min_x, min_y, max_x, max_y;
+};
+
+/**
+ * Čekající otřes částice po výbuchu.
+ */
+struct Disturbance {
+    int x, y;                                            // Buňka (otřese se částice, která v ní právě je)
+    float strength;                                      // Síla otřesu 0-1 (slábne se vzdáleností od výbuchu)
+};
+
+/**
+ * Skupina částic jedné barvy, která spojila okraje desky a vybuchne.
+ */
+struct ExplosionGroup {
+    Color color;                                         // Barva skupiny
+    int grains;                                          // Počet částic skupiny
+};
 
 /**
  * Správa herní desky, fyziky částic a výbuchových efektů.
  * Implementuje prostorovou mříž pro efektivní detekci kolizí O(1),
- * gravitaci, BFS algoritmus pro hledání propojených skupin částic
+ * gravitaci, značkování komponent pro hledání propojených skupin částic
  * a třífázový výbuchový systém (NONE -> ZOOMING -> EXPLODING).
  */
 class Board {
@@ -25,29 +80,71 @@ public:
 
     int width, height;                                              // Rozměry desky v buňkách částic
     std::vector<Particle*> particles;                              // Všechny aktivní částice na desce
+    std::vector<Particle> particle_pool;                           // Aréna částic (nemění velikost - ukazatele platí po celou hru)
+    std::vector<Particle*> free_particles;                         // Volné částice arény
     std::vector<ExplosionParticle> explosion_particles;            // Efektové částice výbuchu
     std::vector<std::vector<Particle*>> grid;                      // 2D mříž pro O(1) detekci kolizí
+    unsigned int id;                                               // Jedinečné číslo desky (pro snímky)
+    std::mt19937 rng;                                              // Náhoda desky (nezávislá na gen - desky běží souběžně)
+    std::mt19937 shake_rng;                                        // Náhoda třesení obrazovky (jen vykreslování, neposouvá rng)
     RenderTexture2D background_texture;                            // Předrenderované pozadí pro výkon
+    int background_scale;                                          // Pixely pozadí na částici (velké desky méně)
+    Texture2D overview_texture;                                    // Přehled desky 1 texel = 1 částice (hlavní vlákno)
+    std::vector<unsigned int> overview_row_versions;               // Verze řádků nahraných do přehledu
 
     int shake_amount, shake_duration, dir_index;                   // Parametry třesení obrazovky
     bool grid_dirty;                                               // Příznak pro rebuild mříže
+    int landed_count;                                              // Částice, které v posledním ticku tvrdě dopadly
+    std::vector<Particle*> unsettled_particles;                    // Neusazené částice (velikost = živý počet)
+    std::vector<Particle*> gravity_batch;                          // Pracovní dávka gravitace jednoho ticku
+    std::vector<Disturbance> pending_disturbances;                 // Otřesy po výbuchu, od nejbližšího
+    size_t disturbance_cursor;                                     // První neprovedený otřes
+    std::vector<int> disturbance_distance;                         // Pracovní vzdálenosti od výbuchu (width * height)
+    std::vector<int> disturbance_cells;                            // Pracovní fronta buněk pro výpočet vzdáleností
+    std::vector<unsigned int> row_versions;                        // Verze řádků - mění se při každé změně řádku
+    unsigned int change_version;                                   // Poslední přidělená verze
+    std::chrono::steady_clock::time_point tick_deadline;           // Konec rozpočtu aktuálního ticku
 
     ExplosionState explosion_state;                                // Aktuální stav výbuchu
     int explosion_timer;                                           // Časovač výbuchové animace
-    std::set<Particle*> particles_to_explode;                      // Částice určené k výbuchu
-    std::unordered_map<Particle*, float> particle_scale_factors;   // Škálovací faktory pro zoom animaci
+    std::vector<Particle*> particles_to_explode;                   // Částice určené k výbuchu
+    std::vector<unsigned char> explode_marks;                      // Značky částic k výbuchu podle indexu v aréně
+    float explosion_scale;                                         // Škálovací faktor zoom animace (stejný pro všechny)
     Color explosion_flash_color;                                   // Barva blesku při výbuchu
+    std::vector<BoardEvent> change_events;                         // Změny od poslední kontroly spojení (jedna na druh)
+    std::vector<ExplosionGroup> exploding_groups;                  // Skupiny aktuálního výbuchu (kombo)
+    std::vector<BoardEvent> connection_regions;                    // Pracovní oblasti změn pro kontrolu spojení
+    std::vector<unsigned char> component_visited;                  // Pracovní značky prošlých buněk (width * height)
+    std::vector<int> component_cells;                              // Pracovní fronta / buňky nalezených skupin
 
     /**
-     * Konstruktor - inicializuje desku, vytvoří mříž a pozadí.
+     * Konstruktor - inicializuje desku podle BOARD_WIDTH × BOARD_HEIGHT,
+     * vytvoří mříž a pozadí. Veškerá paměť desky odpovídá její velikosti
+     * a alokuje se tady - během hry už deska nealokuje.
      */
     Board();
 
     /**
-     * Destruktor - uvolňuje paměť alokovanou pro částice.
+     * Destruktor - uvolní textury desky.
      */
     ~Board();
 
+    Board(const Board&) = delete;
+    Board& operator=(const Board&) = delete;
+
+    /**
+     * Vezme volnou částici z arény a zkopíruje do ní zdroj.
+     * @param source Hodnoty nové částice
+     * @return Částice v aréně, nullptr pokud je aréna vyčerpaná
+     */
+    Particle* AllocateParticle(const Particle& source);
+
+    /**
+     * Vrátí částici do arény (po odebrání z particles a z mříže).
+     * @param particle Částice z AllocateParticle
+     */
+    void ReleaseParticle(Particle* particle);
+
     /**
      * Vytvoří předrenderovanou texturu pozadí pro optimalizaci výkonu.
      */
@@ -85,35 +182,110 @@ public:
     bool CheckCollision(const std::vector<Particle>& test_particles);
 
     /**
-     * Přestaví prostorovou mříž na základě aktuálních pozic částic.
-     * Volá se po pohybu částic nebo změně jejich pozic.
+     * Označí řádek jako změněný (pohyb, přidání, odebrání nebo usazení částice).
+     * Každý odběratel změn si pamatuje naposledy viděnou verzi řádku,
+     * takže změny může sledovat více nezávislých odběratelů najednou.
+     * @param y Index řádku (mimo desku se ignoruje)
+     */
+    void MarkRowDirty(int y) {
+        if (y >= 0 && y < height) row_versions[y] = ++change_version;
+    }
+
+    /**
+     * Označí všechny řádky jako změněné.
+     */
+    void MarkAllRowsDirty();
+
+    /**
+     * Zaznamená změnu desky; změny stejného druhu se slučují do jednoho obdélníku.
+     * @param type Druh změny
+     * @param min_x Levý okraj dotčené oblasti
+     * @param min_y Horní okraj dotčené oblasti
+     * @param max_x Pravý okraj dotčené oblasti (včetně)
+     * @param max_y Spodní okraj dotčené oblasti (včetně)
+     */
+    void AddChangeEvent(BoardEventType type, int min_x, int min_y, int max_x, int max_y);
+
+    /**
+     * Přestaví prostorovou mříž a seznam neusazených částic na základě
+     * aktuálních pozic částic. Volá se po hromadné změně desky (výbuch,
+     * načtení), běžný pohyb částic mříž udržuje průběžně.
      */
     void RebuildGrid();
 
     /**
-     * Aplikuje gravitaci na neusazené částice.
+     * Probudí usazenou částici - znovu podléhá gravitaci.
+     * @param particle Částice (neusazená se ignoruje)
+     */
+    void WakeParticle(Particle* particle);
+
+    /**
+     * Probudí částice, které ztratily oporu uvolněním buňky: souvislý sloupec
+     * nad ní po první mezeru nebo už padající částici. Usazená částice stojí
+     * jen na buňce pod sebou, takže diagonální sousedé oporu neztrácejí.
+     * Usazený písek jinde na desce se vůbec neprochází.
+     * @param x Sloupec uvolněné buňky
+     * @param y Řádek uvolněné buňky
+     */
+    void WakeColumnAbove(int x, int y);
+
+    /**
+     * Naplánuje otřes částic v okolí vybuchlých buněk (disturbance_cells se
+     * vzdáleností 0). Otřesou se jen částice do DISTURBANCE_RADIUS, síla
+     * lineárně slábne se vzdáleností, zbytek desky zůstane v klidu.
+     */
+    void QueueDisturbances();
+
+    /**
+     * Provede naplánované otřesy od nejbližších, dokud nevyčerpá rozpočet
+     * ticku. Zbytek počká na další tick, takže velký výbuch nezabere celý snímek.
+     */
+    void ApplyDisturbances();
+
+    /**
+     * Zahájí tick: odměří časový rozpočet práce desky (SIM_BUDGET_US).
+     * Práce, na kterou nezbyde čas, se přesune do dalšího ticku v pořadí
+     * priority: padající částice, otřesy po výbuchu, úklid výbuchu a nakonec
+     * kontrola spojení. Kostku hráče rozpočet neomezuje - ovládání se
+     * zpracuje před prací desky a pád kostky po ní.
+     */
+    void BeginTick();
+
+    /**
+     * @return true pokud v aktuálním ticku zbývá rozpočet na práci desky
+     */
+    bool HasTickBudget() const;
+
+    /**
+     * Aplikuje gravitaci na neusazené částice a pak rozpracované otřesy.
      * Částice padají dolů dokud nenarazí na překážku nebo dno.
      */
     void ApplyGravity();
 
     /**
-     * Zkontroluje, zda jsou všechny částice na desce usazené.
-     * @return true pokud jsou všechny částice settled, jinak false
+     * Posune neusazené částice zdola nahoru, dokud zbývá rozpočet ticku
+     * (aspoň jedna dávka proběhne vždy).
      */
-    bool AreAllParticlesSettled();
+    void MoveUnsettledParticles();
 
     /**
-     * Najde všechny propojené částice stejné barvy pomocí BFS algoritmu.
-     * Částice musí být v kontaktu horizontálně nebo vertikálně.
-     * @param start Startovní částice pro BFS
-     * @return Set všech částic v propojené skupině
+     * Zkontroluje, zda jsou všechny částice na desce usazené - O(1).
+     * Čekající otřesy se počítají jako neusazené částice.
+     * @return true pokud jsou všechny částice settled, jinak false
      */
-    std::set<Particle*> FindConnectedGroup(Particle* start);
+    bool AreAllParticlesSettled() const { return unsettled_particles.empty() && pending_disturbances.empty(); }
 
     /**
-     * Kontroluje všechny částice a hledá skupiny 4+ propojených částic stejné barvy.
-     * Pokud najde, označí je k výbuchu.
-     * @return Počet nalezených skupin k výbuchu
+     * Najde všechny skupiny propojených částic stejné barvy, které spojují levý
+     * a pravý okraj desky, a označí je k výbuchu - všechny najednou.
+     * Řídí se změnami desky: bez přidané kostky, usazení nebo náhrady desky
+     * od minulé kontroly nic nepočítá (klidná deska nestojí nic). Samotné
+     * odebrání částic ani padající částice nové spojení nevytvoří - padající
+     * částice se započítají, až se usadí.
+     * Skupiny hledá flood fillem jen od buněk v oblastech změn - nové spojení
+     * musí vést přes přidanou nebo usazenou částici - takže cena závisí na
+     * velikosti dotčených skupin, ne na velikosti desky.
+     * @return Celkový počet částic určených k výbuchu (skupiny viz exploding_groups)
      */
     int CheckHorizontalConnections();
 
@@ -130,9 +302,41 @@ public:
     void UpdateExplosions();
 
     /**
-     * Vykreslí desku, všechny částice a výbuchové efekty.
+     * Zkopíruje aktuální stav desky do snímku pro vykreslení - buňky jen
+     * ve změněných řádcích.
+     * @param frame Výstupní snímek (vektory si drží kapacitu, opakované volání nealokuje)
+     */
+    void CaptureFrame(BoardFrame& frame);
+
+    /**
+     * Vykreslí viditelnou část snímku desky - částice a výbuchové efekty.
+     * Prochází jen buňky uvnitř view, cena závisí na velikosti obrazovky.
+     * Čte jen snímek a texturu pozadí, simulace mezitím může běžet.
+     * @param frame Snímek z CaptureFrame
+     * @param view Viditelná oblast v buňkách částic
      * @param offset_x Horizontální offset na obrazovce
      * @param offset_y Vertikální offset na obrazovce
      */
-    void Draw(int offset_x, int offset_y);
+    void Draw(const BoardFrame& frame, Rectangle view, int offset_x, int offset_y) const;
+
+    /**
+     * Vykreslí snímek desky jako přehledovou texturu (1 texel = 1 částice)
+     * pro oddálený pohled, kdy je částice menší než pixel. Do textury se
+     * nahrají jen řádky změněné od minula. Volá jen hlavní vlákno.
+     * @param frame Snímek z CaptureFrame
+     * @param offset_x Horizontální offset na obrazovce
+     * @param offset_y Vertikální offset na obrazovce
+     */
+    void DrawOverview(const BoardFrame& frame, int offset_x, int offset_y);
+
+private:
+    /**
+     * Vykreslí pozadí a rámeček desky (společné oběma pohledům).
+     */
+    void DrawBackground(int offset_x, int offset_y) const;
+
+    /**
+     * Vykreslí záblesk a efektové částice výbuchu uvnitř view (společné oběma pohledům).
+     */
+    void DrawEffects(const BoardFrame& frame, Rectangle view, int offset_x, int offset_y) const;
 };
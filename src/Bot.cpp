@@ -0,0 +1,264 @@
+#include "Bot.hpp"
+#include "Constants.hpp"
+#include "Shapes.hpp"
+#include "Utils.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace {
+constexpr int BEAM_WIDTH = 4;                    // Počet nejlepších kandidátů rozvíjených do hloubky
+constexpr float NEXT_PIECE_WEIGHT = 0.9f;        // Váha ohodnocení s další kostkou
+constexpr float INVALID_SCORE = -std::numeric_limits<float>::infinity();
+
+// Pracovní buffery simulace - jedny na vlákno poolu, po prvním tahu už nealokují
+thread_local std::vector<std::pair<int, int>> placement_grains;
+thread_local std::vector<int> evaluate_labels;
+thread_local std::vector<int> evaluate_stack;
+}
+
+BotBoard::BotBoard(int width, int height)
+    : width(width), height(height), cells(width * height, 0) {}
+
+void BotBoard::Capture(const Board& board) {
+    width = board.width;
+    height = board.height;
+    cells.assign(width * height, 0);
+    for (auto p : board.particles) {
+        int px = (int)p->x;
+        int py = (int)p->y;
+        if (px >= 0 && px < board.width && py >= 0 && py < board.height) {
+            Set(px, py, (unsigned char)(std::max(0, GetColorIndex(p->color)) + 1));
+        }
+    }
+}
+
+Bot::Bot(ThreadPool& pool) : pool(pool), snapshot(0, 0), children(BEAM_WIDTH) {}
+
+void Bot::EnumerateCandidates(const BotBoard& board, int shape_type, std::vector<Candidate>& out, size_t& next_board) {
+    out.clear();
+    int blocks_width = board.width / PARTICLES_PER_BLOCK;
+    int rotations = (shape_type == 0) ? 1 : 4; // O vypadá ve všech rotacích stejně
+
+    for (int rotation = 0; rotation < rotations; rotation++) {
+        // Rozsah x, při kterém zůstane celý tvar uvnitř desky
+        int min_bx = 4, max_bx = 0;
+        for (auto& block : GetShape(shape_type, rotation)) {
+            min_bx = std::min(min_bx, (int)block.x);
+            max_bx = std::max(max_bx, (int)block.x);
+        }
+        for (int board_x = -min_bx; board_x + max_bx < blocks_width; board_x++) {
+            out.push_back({rotation, board_x, &board, &boards[next_board++], INVALID_SCORE, false});
+        }
+    }
+}
+
+bool Bot::SimulatePlacement(Candidate& candidate, int shape_type, unsigned char color) {
+    // Kopie do desky stejných rozměrů nealokuje
+    BotBoard& board = *candidate.result;
+    board = *candidate.source;
+    auto shape = GetShape(shape_type, candidate.rotation);
+
+    // Kolize celého tvaru na dané pozici (po buňkách částic jako Board::CheckCollision)
+    auto collides = [&](int board_y) {
+        for (auto& block : shape) {
+            int x0 = (candidate.board_x + (int)block.x) * PARTICLES_PER_BLOCK;
+            int y0 = (board_y + (int)block.y) * PARTICLES_PER_BLOCK;
+            for (int py = y0; py < y0 + PARTICLES_PER_BLOCK; py++) {
+                if (py >= board.height) return true;
+                if (py < 0) continue;
+                for (int px = x0; px < x0 + PARTICLES_PER_BLOCK; px++) {
+                    if (board.Get(px, py) != 0) return true;
+                }
+            }
+        }
+        return false;
+    };
+
+    if (collides(0)) return false;
+
+    int board_y = 0;
+    while (!collides(board_y + 1)) board_y++;
+
+    // Zapsat částice kostky a sesypat je zdola nahoru (jako písek)
+    std::vector<std::pair<int, int>>& grains = placement_grains;
+    grains.clear();
+    for (auto& block : shape) {
+        for (int px = 0; px < PARTICLES_PER_BLOCK; px++) {
+            for (int py = 0; py < PARTICLES_PER_BLOCK; py++) {
+                int gx = (candidate.board_x + (int)block.x) * PARTICLES_PER_BLOCK + px;
+                int gy = (board_y + (int)block.y) * PARTICLES_PER_BLOCK + py;
+                board.Set(gx, gy, color);
+                grains.emplace_back(gx, gy);
+            }
+        }
+    }
+    std::sort(grains.begin(), grains.end(),
+              [](const std::pair<int, int>& a, const std::pair<int, int>& b) { return a.second > b.second; });
+
+    for (auto& grain : grains) {
+        int x = grain.first;
+        int y = grain.second;
+        board.Set(x, y, 0);
+        while (y + 1 < board.height) {
+            if (board.Get(x, y + 1) == 0) {
+                y++;
+            } else if (x > 0 && board.Get(x - 1, y + 1) == 0) {
+                x--;
+                y++;
+            } else if (x + 1 < board.width && board.Get(x + 1, y + 1) == 0) {
+                x++;
+                y++;
+            } else {
+                break;
+            }
+        }
+        board.Set(x, y, color);
+    }
+
+    candidate.score = Evaluate(board);
+    candidate.valid = true;
+    return true;
+}
+
+float Bot::Evaluate(BotBoard& board) {
+    int w = board.width;
+    int h = board.height;
+    std::vector<int>& labels = evaluate_labels;
+    std::vector<int>& stack = evaluate_stack;
+    labels.assign(w * h, -1);
+    stack.reserve(w * h);
+
+    float cleared = 0.0f;
+    float reach = 0.0f;
+
+    // Flood fill všech komponent stejné barvy (4-okolí jako Board::CheckHorizontalConnections)
+    int label = 0;
+    for (int sy = 0; sy < h; sy++) {
+        for (int sx = 0; sx < w; sx++) {
+            unsigned char color = board.Get(sx, sy);
+            if (color == 0 || labels[sy * w + sx] >= 0) continue;
+
+            int min_x = sx, max_x = sx, size = 0;
+            stack.clear();
+            stack.push_back(sy * w + sx);
+            labels[sy * w + sx] = label;
+            while (!stack.empty()) {
+                int index = stack.back();
+                stack.pop_back();
+                int x = index % w;
+                int y = index / w;
+                size++;
+                min_x = std::min(min_x, x);
+                max_x = std::max(max_x, x);
+
+                constexpr int dirs[][2] = {{0, 1}, {0, -1}, {1, 0}, {-1, 0}};
+                for (auto& dir : dirs) {
+                    int nx = x + dir[0];
+                    int ny = y + dir[1];
+                    if (nx < 0 || nx >= w || ny < 0 || ny >= h) continue;
+                    int n = ny * w + nx;
+                    if (labels[n] < 0 && board.Get(nx, ny) == color) {
+                        labels[n] = label;
+                        stack.push_back(n);
+                    }
+                }
+            }
+
+            if (min_x == 0 && max_x == w - 1) {
+                cleared += size;
+                // Odstranit skupinu, další kostka se hodnotí už bez ní
+                for (int i = 0; i < w * h; i++) {
+                    if (labels[i] == label) board.Set(i % w, i / w, 0);
+                }
+            } else {
+                float extent = (float)(max_x - min_x + 1) / w;
+                reach += extent * extent * size;
+            }
+            label++;
+        }
+    }
+
+    // Výšky sloupců, nejvyšší bod a nerovnost povrchu
+    int max_height = 0;
+    float bumpiness = 0.0f;
+    int previous_height = -1;
+    for (int x = 0; x < w; x++) {
+        int y = 0;
+        while (y < h && board.Get(x, y) == 0) y++;
+        int column_height = h - y;
+        max_height = std::max(max_height, column_height);
+        if (previous_height >= 0) bumpiness += (float)std::abs(column_height - previous_height);
+        previous_height = column_height;
+    }
+
+    // Nebezpečná zóna u spawnu - hrozí konec hry
+    float danger = (max_height > h - 4 * PARTICLES_PER_BLOCK) ? 10000.0f : 0.0f;
+
+    return cleared * 10.0f + reach * 0.5f - max_height * 2.0f - bumpiness * 0.5f - danger;
+}
+
+BotPlacement Bot::FindBestPlacement(const Board& board, const Tetromino& current, const Tetromino* next) {
+    snapshot.Capture(board);
+    unsigned char current_color = (unsigned char)(std::max(0, GetColorIndex(current.color)) + 1);
+
+    // Desky pro nejvýš 4 rotace × všechny sloupce, pro aktuální kostku i každého
+    // kandidáta paprsku - alokují se jen při prvním tahu (nebo změně rozměrů)
+    size_t max_candidates = 4 * (size_t)(board.width / PARTICLES_PER_BLOCK);
+    if (boards.size() < max_candidates * (1 + BEAM_WIDTH) ||
+        boards[0].width != board.width || boards[0].height != board.height) {
+        boards.assign(max_candidates * (1 + BEAM_WIDTH), BotBoard(board.width, board.height));
+        candidates.reserve(max_candidates);
+        for (auto& list : children) list.reserve(max_candidates);
+        beam.reserve(max_candidates);
+        totals.reserve(BEAM_WIDTH);
+    }
+    size_t next_board = 0;
+
+    // Úroveň 1 - všechna umístění aktuální kostky paralelně
+    EnumerateCandidates(snapshot, current.shape_type, candidates, next_board);
+    for (auto& candidate : candidates) {
+        Candidate* c = &candidate;
+        int shape_type = current.shape_type;
+        pool.Submit([c, shape_type, current_color] { SimulatePlacement(*c, shape_type, current_color); }, &placement_group);
+    }
+    pool.Wait(placement_group);
+
+    beam.clear();
+    for (auto& candidate : candidates) {
+        if (candidate.valid) beam.push_back(&candidate);
+    }
+    if (beam.empty()) return {0, current.board_x, INVALID_SCORE, false};
+
+    std::sort(beam.begin(), beam.end(), [](Candidate* a, Candidate* b) { return a->score > b->score; });
+    if ((int)beam.size() > BEAM_WIDTH) beam.resize(BEAM_WIDTH);
+
+    // Úroveň 2 - rozvinout nejlepší kandidáty o všechna umístění další kostky
+    totals.clear();
+    for (size_t i = 0; i < beam.size(); i++) totals.push_back(beam[i]->score);
+
+    if (next) {
+        unsigned char next_color = (unsigned char)(std::max(0, GetColorIndex(next->color)) + 1);
+        for (size_t i = 0; i < beam.size(); i++) {
+            EnumerateCandidates(*beam[i]->result, next->shape_type, children[i], next_board);
+            for (auto& child : children[i]) {
+                Candidate* c = &child;
+                int shape_type = next->shape_type;
+                pool.Submit([c, shape_type, next_color] { SimulatePlacement(*c, shape_type, next_color); }, &placement_group);
+            }
+        }
+        pool.Wait(placement_group);
+
+        for (size_t i = 0; i < beam.size(); i++) {
+            float best_child = INVALID_SCORE;
+            for (auto& child : children[i]) {
+                if (child.valid) best_child = std::max(best_child, child.score);
+            }
+            if (best_child > INVALID_SCORE) {
+                totals[i] = beam[i]->score * (1.0f - NEXT_PIECE_WEIGHT) + best_child * NEXT_PIECE_WEIGHT;
+            }
+        }
+    }
+
+    size_t best = std::max_element(totals.begin(), totals.end()) - totals.begin();
+    return {beam[best]->rotation, beam[best]->board_x, totals[best], true};
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "Board.hpp"
+#include "Tetromino.hpp"
+#include "ThreadPool.hpp"
+#include <vector>
+
+/**
+ * Kompaktní snímek herní desky pro simulaci bota.
+ * Každá buňka obsahuje index barvy + 1 (0 = prázdná buňka).
+ * Kopie do desky stejných rozměrů jen přepíše buffer - bot si desky
+ * kandidátů drží mezi tahy a během hry už nealokuje.
+ */
+class BotBoard {
+public:
+    int width, height;  // Rozměry v buňkách částic
+
+    /**
+     * Konstruktor - vytvoří prázdnou desku.
+     * @param width Šířka v buňkách částic
+     * @param height Výška v buňkách částic
+     */
+    BotBoard(int width, int height);
+
+    /**
+     * Přepíše snímek aktuálním stavem herní desky (převezme i její rozměry).
+     * @param board Zdrojová herní deska
+     */
+    void Capture(const Board& board);
+
+    /**
+     * @return Obsah buňky (0 = prázdná, jinak index barvy + 1)
+     */
+    unsigned char Get(int x, int y) const { return cells[y * width + x]; }
+
+    /**
+     * Zapíše buňku.
+     */
+    void Set(int x, int y, unsigned char value) { cells[y * width + x] = value; }
+
+private:
+    std::vector<unsigned char> cells;  // Data buněk (řádek po řádku)
+};
+
+/**
+ * Umístění tetromina vybrané botem.
+ */
+struct BotPlacement {
+    int rotation;   // Cílová rotace (0-3)
+    int board_x;    // Cílová pozice x v buňkách desky
+    float score;    // Ohodnocení umístění
+    bool valid;     // false pokud neexistuje žádné platné umístění
+};
+
+/**
+ * Automatický hráč založený na prohledávání umístění.
+ * Pro každou rotaci a sloupec nasimuluje dopad kostky, sesypání písku
+ * a propojení barev, a pomocí beam search přes aktuální a další kostku
+ * vybere nejlepší umístění. Kandidáti se hodnotí paralelně v poolu vláken.
+ */
+class Bot {
+public:
+    /**
+     * Konstruktor.
+     * @param pool Pool vláken pro paralelní hodnocení kandidátů
+     */
+    explicit Bot(ThreadPool& pool);
+
+    /**
+     * Najde nejlepší umístění aktuální kostky.
+     * @param board Herní deska
+     * @param current Aktuálně padající tetromino
+     * @param next Následující tetromino (může být nullptr)
+     * @return Nejlepší nalezené umístění
+     */
+    BotPlacement FindBestPlacement(const Board& board, const Tetromino& current, const Tetromino* next);
+
+private:
+    /**
+     * Kandidát prohledávání - umístění a výsledná deska po sesypání.
+     * Desky patří do boards, kandidát na ně jen ukazuje.
+     */
+    struct Candidate {
+        int rotation, board_x;
+        const BotBoard* source;  // Deska před umístěním
+        BotBoard* result;        // Deska po umístění a sesypání
+        float score;
+        bool valid;
+    };
+
+    ThreadPool& pool;                              // Sdílený pool vláken
+    TaskGroup placement_group;                     // Úlohy hodnocení kandidátů (čeká se jen na ně)
+    BotBoard snapshot;                             // Snímek herní desky aktuálního tahu
+    std::vector<BotBoard> boards;                  // Výsledné desky kandidátů (znovu použité každý tah)
+    std::vector<Candidate> candidates;             // Umístění aktuální kostky
+    std::vector<std::vector<Candidate>> children;  // Umístění další kostky pro každého kandidáta paprsku
+    std::vector<Candidate*> beam;                  // Nejlepší kandidáti aktuální kostky
+    std::vector<float> totals;                     // Celkové ohodnocení kandidátů paprsku
+
+    /**
+     * Naplní seznam všemi rotacemi a sloupci pro daný tvar.
+     * @param board Deska před umístěním
+     * @param shape_type Typ tvaru
+     * @param out Výstupní seznam (přepíše se)
+     * @param next_board Index další volné desky v boards (posune se)
+     */
+    void EnumerateCandidates(const BotBoard& board, int shape_type, std::vector<Candidate>& out, size_t& next_board);
+
+    /**
+     * Nasimuluje dopad kostky, sesypání písku a ohodnotí výsledek.
+     * @return false pokud kostku nelze na dané místo umístit
+     */
+    static bool SimulatePlacement(Candidate& candidate, int shape_type, unsigned char color);
+
+    /**
+     * Ohodnotí desku (propojení barev, výška, nerovnost povrchu).
+     * Skupiny spojující oba okraje z desky odstraní jako při výbuchu.
+     */
+    static float Evaluate(BotBoard& board);
+};
@@ -0,0 +1,287 @@
+#include "ClipRecorder.hpp"
+#include "Constants.hpp"
+#include "Utils.hpp"
+#include <algorithm>
+
+namespace {
+constexpr int CLIP_TARGET_SIZE = 400;          // Delší strana obrázku malých desek v pixelech
+constexpr int GIF_MIN_CODE_SIZE = 3;           // 8 barev palety
+constexpr int GIF_CLEAR_CODE = 1 << GIF_MIN_CODE_SIZE;
+constexpr int GIF_MAX_CODE = 4095;             // Největší kód LZW (12 bitů)
+
+// Pevná paleta: pozadí, barvy ALL_COLORS, bílá pro barvy mimo paletu
+constexpr int CLIP_PALETTE_SIZE = 1 << GIF_MIN_CODE_SIZE;
+static_assert(PALETTE_SIZE + 2 <= CLIP_PALETTE_SIZE, "Paleta záznamu musí pojmout ALL_COLORS");
+
+Color ClipPaletteColor(int index) {
+    if (index == 0) return BG_COLOR_TOP;
+    if (index <= PALETTE_SIZE) return ALL_COLORS[index - 1];
+    return WHITE;
+}
+
+unsigned char ClipPaletteIndex(Color color) {
+    int index = GetColorIndex(color);
+    return (unsigned char)(index >= 0 ? index + 1 : CLIP_PALETTE_SIZE - 1);
+}
+
+/**
+ * Zápis kódů LZW po bitech (od nejnižšího) do pod-bloků GIF o nejvýš 255 bajtech.
+ */
+struct GifBitWriter {
+    std::vector<unsigned char>& out;
+    size_t block_start;          // Pozice bajtu s délkou aktuálního pod-bloku
+    unsigned int bits;           // Nezapsané bity
+    int bit_count;               // Počet nezapsaných bitů
+
+    explicit GifBitWriter(std::vector<unsigned char>& out) : out(out), block_start(out.size()), bits(0), bit_count(0) {
+        out.push_back(0);
+    }
+
+    void PutByte(unsigned char byte) {
+        if (out.size() - block_start - 1 == 255) {
+            out[block_start] = 255;
+            block_start = out.size();
+            out.push_back(0);
+        }
+        out.push_back(byte);
+    }
+
+    void PutCode(int code, int code_size) {
+        bits |= (unsigned int)code << bit_count;
+        bit_count += code_size;
+        while (bit_count >= 8) {
+            PutByte((unsigned char)(bits & 0xFF));
+            bits >>= 8;
+            bit_count -= 8;
+        }
+    }
+
+    void Finish() {
+        if (bit_count > 0) PutByte((unsigned char)(bits & 0xFF));
+        out[block_start] = (unsigned char)(out.size() - block_start - 1);
+        if (out[block_start] != 0) out.push_back(0);  // Prázdný pod-blok ukončuje data
+    }
+};
+}
+
+ClipRecorder::ClipRecorder(const std::string& path, int width, int height, int frame_interval, int slot_count, int encoder_count)
+    : path(path), gif(false), is_open(false), file(nullptr), width(width), height(height),
+      pixel_scale(std::max(1, CLIP_TARGET_SIZE / std::max(1, std::max(width, height)))),
+      frame_interval(std::max(1, frame_interval)), frame_counter(0), dropped_frames(0),
+      slots(std::max(2, slot_count)), captured_frames(0), next_encode(0), next_write(0),
+      writing(false), stopping(false) {
+    gif = path.size() >= 4 && path.compare(path.size() - 4, 4, ".gif") == 0;
+
+    if (gif) {
+        file = std::fopen(path.c_str(), "wb");
+        if (!file) {
+            TraceLog(LOG_WARNING, "CAPTURE: Failed to open %s", path.c_str());
+            return;
+        }
+
+        // Hlavička, globální paleta a nekonečné opakování (NETSCAPE2.0)
+        std::vector<unsigned char> header = {'G', 'I', 'F', '8', '9', 'a'};
+        int image_width = width * pixel_scale;
+        int image_height = height * pixel_scale;
+        header.insert(header.end(), {(unsigned char)(image_width & 0xFF), (unsigned char)(image_width >> 8),
+                                     (unsigned char)(image_height & 0xFF), (unsigned char)(image_height >> 8),
+                                     (unsigned char)(0x80 | ((GIF_MIN_CODE_SIZE - 1) << 4) | (GIF_MIN_CODE_SIZE - 1)), 0, 0});
+        for (int i = 0; i < CLIP_PALETTE_SIZE; i++) {
+            Color c = ClipPaletteColor(i);
+            header.insert(header.end(), {c.r, c.g, c.b});
+        }
+        const char loop[] = "\x21\xFF\x0BNETSCAPE2.0\x03\x01\x00\x00\x00";
+        header.insert(header.end(), loop, loop + sizeof(loop) - 1);
+        std::fwrite(header.data(), 1, header.size(), file);
+    }
+
+    // Všechny buffery předem - zachycení v herní smyčce už nealokuje
+    for (Slot& slot : slots) {
+        slot.state = SlotState::FREE;
+        slot.frame = 0;
+        slot.cells.resize(width * height);
+        slot.piece.reserve(4 * PARTICLES_PER_BLOCK * PARTICLES_PER_BLOCK);
+    }
+
+    is_open = true;
+    for (int i = 0; i < std::max(1, encoder_count); i++) {
+        encoders.emplace_back(&ClipRecorder::EncoderLoop, this);
+    }
+    TraceLog(LOG_INFO, "CAPTURE: Recording %s (%dx%d px)", path.c_str(), width * pixel_scale, height * pixel_scale);
+}
+
+ClipRecorder::~ClipRecorder() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    frame_ready.notify_all();
+    for (std::thread& encoder : encoders) encoder.join();
+
+    if (file) {
+        std::fputc(0x3B, file);  // Konec GIF
+        std::fclose(file);
+    }
+    if (dropped_frames > 0) {
+        TraceLog(LOG_WARNING, "CAPTURE: %d frames dropped (encoder too slow)", dropped_frames);
+    }
+}
+
+void ClipRecorder::CaptureFrame(const BoardFrame& board, const std::vector<Particle>& piece) {
+    if (!is_open || board.width != width || board.height != height) return;
+    if (++frame_counter < frame_interval) return;
+    frame_counter = 0;
+
+    Slot* slot;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        slot = &slots[captured_frames % slots.size()];
+        if (slot->state != SlotState::FREE) {
+            dropped_frames++;
+            return;
+        }
+    }
+
+    // Volný slot patří až do předání jen hlavnímu vláknu
+    std::copy(board.cells.begin(), board.cells.end(), slot->cells.begin());
+    slot->piece.assign(piece.begin(), piece.end());
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        slot->frame = captured_frames++;
+        slot->state = SlotState::CAPTURED;
+    }
+    frame_ready.notify_one();
+}
+
+void ClipRecorder::EncoderLoop() {
+    std::vector<unsigned char> pixels(width * pixel_scale * height * pixel_scale);
+    std::vector<unsigned short> lzw_table(gif ? (GIF_MAX_CODE + 1) * CLIP_PALETTE_SIZE : 0);
+    std::vector<Color> rgba(gif ? 0 : pixels.size());
+
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        frame_ready.wait(lock, [this] { return stopping || next_encode < captured_frames; });
+        if (next_encode >= captured_frames) return;
+
+        Slot& slot = slots[next_encode++ % slots.size()];
+        slot.state = SlotState::ENCODING;
+        lock.unlock();
+
+        RenderIndexed(slot, pixels);
+        if (gif) {
+            EncodeGifFrame(pixels, slot.encoded, lzw_table);
+        } else {
+            WritePng(slot.frame, pixels, rgba);
+        }
+
+        lock.lock();
+        if (gif) {
+            slot.state = SlotState::ENCODED;
+            WriteEncodedFrames(lock);
+        } else {
+            slot.state = SlotState::FREE;
+        }
+    }
+}
+
+void ClipRecorder::RenderIndexed(const Slot& slot, std::vector<unsigned char>& pixels) const {
+    int image_width = width * pixel_scale;
+    auto fill = [&](int x, int y, unsigned char index) {
+        unsigned char* row = &pixels[(y * pixel_scale) * image_width + x * pixel_scale];
+        for (int py = 0; py < pixel_scale; py++, row += image_width) {
+            std::fill(row, row + pixel_scale, index);
+        }
+    };
+
+    for (int y = 0; y < height; y++) {
+        const Color* row = &slot.cells[y * width];
+        for (int x = 0; x < width; x++) {
+            fill(x, y, row[x].a == 0 ? 0 : ClipPaletteIndex(row[x]));
+        }
+    }
+    for (const Particle& p : slot.piece) {
+        int x = (int)p.x, y = (int)p.y;
+        if (x < 0 || x >= width || y < 0 || y >= height) continue;
+        fill(x, y, ClipPaletteIndex(p.color));
+    }
+}
+
+void ClipRecorder::EncodeGifFrame(const std::vector<unsigned char>& pixels, std::vector<unsigned char>& out,
+                                  std::vector<unsigned short>& lzw_table) const {
+    out.clear();
+    int image_width = width * pixel_scale;
+    int image_height = height * pixel_scale;
+
+    // Řídicí blok - zpoždění v setinách sekundy podle intervalu ukládání
+    int delay = std::max(2, frame_interval * 100 / FPS);
+    out.insert(out.end(), {0x21, 0xF9, 0x04, 0x00, (unsigned char)(delay & 0xFF), (unsigned char)(delay >> 8), 0x00, 0x00});
+
+    // Popis obrázku přes celé plátno bez lokální palety
+    out.insert(out.end(), {0x2C, 0, 0, 0, 0,
+                           (unsigned char)(image_width & 0xFF), (unsigned char)(image_width >> 8),
+                           (unsigned char)(image_height & 0xFF), (unsigned char)(image_height >> 8), 0x00});
+    out.push_back(GIF_MIN_CODE_SIZE);
+
+    // LZW - slovník jako strom: lzw_table[kód * barvy + barva] = kód prodlouženého řetězce (0 = není)
+    GifBitWriter writer(out);
+    int code_size = GIF_MIN_CODE_SIZE + 1;
+    int max_code = GIF_CLEAR_CODE + 1;
+    std::fill(lzw_table.begin(), lzw_table.end(), 0);
+    writer.PutCode(GIF_CLEAR_CODE, code_size);
+
+    int current = pixels[0];
+    for (size_t i = 1; i < pixels.size(); i++) {
+        int next = pixels[i];
+        unsigned short& child = lzw_table[current * CLIP_PALETTE_SIZE + next];
+        if (child != 0) {
+            current = child;
+            continue;
+        }
+
+        writer.PutCode(current, code_size);
+        child = (unsigned short)++max_code;
+        if (max_code >= (1 << code_size)) code_size++;
+        if (max_code == GIF_MAX_CODE) {
+            // Plný slovník - začít znovu
+            writer.PutCode(GIF_CLEAR_CODE, code_size);
+            std::fill(lzw_table.begin(), lzw_table.end(), 0);
+            code_size = GIF_MIN_CODE_SIZE + 1;
+            max_code = GIF_CLEAR_CODE + 1;
+        }
+        current = next;
+    }
+    writer.PutCode(current, code_size);
+    writer.PutCode(GIF_CLEAR_CODE + 1, code_size);
+    writer.Finish();
+}
+
+void ClipRecorder::WritePng(unsigned int frame, const std::vector<unsigned char>& pixels, std::vector<Color>& rgba) const {
+    for (size_t i = 0; i < pixels.size(); i++) rgba[i] = ClipPaletteColor(pixels[i]);
+
+    // TextFormat má sdílené buffery - z pracovního vlákna vlastní
+    char file_name[1024];
+    std::snprintf(file_name, sizeof(file_name), "%s_%05u.png", path.c_str(), frame);
+    Image image = {rgba.data(), width * pixel_scale, height * pixel_scale, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8};
+    if (!ExportImage(image, file_name)) {
+        TraceLog(LOG_WARNING, "CAPTURE: Failed to write %s", file_name);
+    }
+}
+
+void ClipRecorder::WriteEncodedFrames(std::unique_lock<std::mutex>& lock) {
+    // Snímky se kódují souběžně, do souboru ale musí jít popořadě
+    if (writing) return;
+    writing = true;
+    for (;;) {
+        Slot& slot = slots[next_write % slots.size()];
+        if (slot.state != SlotState::ENCODED || slot.frame != next_write) break;
+
+        lock.unlock();
+        std::fwrite(slot.encoded.data(), 1, slot.encoded.size(), file);
+        lock.lock();
+
+        slot.state = SlotState::FREE;
+        next_write++;
+    }
+    writing = false;
+}
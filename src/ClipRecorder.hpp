@@ -0,0 +1,142 @@
+#pragma once
+
+#include "Board.hpp"
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Záznam hry do obrázků pro hlášení chyb (--capture).
+ *
+ * Herní smyčka jen zkopíruje buňky desky a padající kostku do kruhu
+ * předem alokovaných slotů, kódování i zápis na disk běží na vlastních
+ * vláknech (sdílený pool ne - na ten čeká simulace i bot). Obrázek má
+ * na částici čtverec pixelů (malé desky se zvětší na ~400 px) a pevnou
+ * paletu (pozadí + ALL_COLORS).
+ * - Cesta končící .gif: animovaný GIF, snímky se kódují souběžně a
+ *   zapisují ve správném pořadí. S 8 barvami je LZW velmi úsporné.
+ * - Jinak sekvence PNG <cesta>_00000.png, <cesta>_00001.png, ...
+ *
+ * Když kodéry nestíhají a kruh je plný, snímek se zahodí (počítá se).
+ */
+class ClipRecorder {
+public:
+    /**
+     * Konstruktor - otevře výstup a spustí kódovací vlákna.
+     * @param path Cesta ke GIF, nebo předpona PNG sekvence
+     * @param width Šířka desky v buňkách částic
+     * @param height Výška desky v buňkách částic
+     * @param frame_interval Ukládat každý kolikátý snímek (GIF pak má zpoždění podle FPS)
+     * @param slot_count Počet slotů kruhu
+     * @param encoder_count Počet kódovacích vláken
+     */
+    ClipRecorder(const std::string& path, int width, int height, int frame_interval = 3,
+                 int slot_count = 32, int encoder_count = 2);
+
+    /**
+     * Destruktor - dokóduje a zapíše zachycené snímky a ukončí vlákna.
+     */
+    ~ClipRecorder();
+
+    ClipRecorder(const ClipRecorder&) = delete;
+    ClipRecorder& operator=(const ClipRecorder&) = delete;
+
+    /**
+     * @return true pokud se výstup podařilo otevřít
+     */
+    bool IsOpen() const { return is_open; }
+
+    /**
+     * Zachytí snímek desky. Jen kopie do volného slotu - nikdy nečeká na kodér ani disk.
+     * Snímky jiných rozměrů než v konstruktoru se ignorují.
+     * @param board Snímek desky
+     * @param piece Částice padající kostky (souřadnice desky)
+     */
+    void CaptureFrame(const BoardFrame& board, const std::vector<Particle>& piece);
+
+    /**
+     * @return Počet snímků zahozených kvůli plnému kruhu
+     */
+    int GetDroppedFrames() const { return dropped_frames; }
+
+private:
+    /**
+     * Stav slotu kruhu.
+     */
+    enum class SlotState {
+        FREE,       // Volný pro zachycení
+        CAPTURED,   // Zachycený, čeká na kodér
+        ENCODING,   // Kóduje se
+        ENCODED     // Zakódovaný, čeká na zápis v pořadí
+    };
+
+    /**
+     * Slot kruhu - buffery se alokují jednou v konstruktoru.
+     */
+    struct Slot {
+        SlotState state;                     // Stav (pod mutex)
+        unsigned int frame;                  // Pořadí snímku v záznamu
+        std::vector<Color> cells;            // Kopie BoardFrame::cells
+        std::vector<Particle> piece;         // Kopie padající kostky
+        std::vector<unsigned char> encoded;  // Zakódovaný snímek GIF (u PNG nepoužito)
+    };
+
+    std::string path;                    // Cesta ke GIF / předpona PNG
+    bool gif;                            // Výstup je GIF (jinak PNG sekvence)
+    bool is_open;                        // Výstup připraven
+    std::FILE* file;                     // Soubor GIF (zapisuje jen vlákno držící writing)
+    int width, height;                   // Rozměry desky v částicích
+    int pixel_scale;                     // Pixely obrázku na částici
+    int frame_interval;                  // Ukládá se každý frame_interval-tý snímek
+    int frame_counter;                   // Snímky od posledního uloženého (hlavní vlákno)
+    int dropped_frames;                  // Počet zahozených snímků (hlavní vlákno)
+
+    std::vector<Slot> slots;             // Kruh slotů
+    unsigned int captured_frames;        // Pořadí příštího zachyceného snímku
+    unsigned int next_encode;            // Pořadí příštího snímku pro kodér
+    unsigned int next_write;             // Pořadí příštího snímku k zápisu (GIF)
+    bool writing;                        // Některé vlákno právě zapisuje do souboru
+    std::mutex mutex;                    // Zámek stavů slotů a čítačů
+    std::condition_variable frame_ready; // Signál nového snímku / ukončení
+    bool stopping;                       // Příznak ukončení vláken
+    std::vector<std::thread> encoders;   // Kódovací vlákna
+
+    /**
+     * Smyčka kódovacího vlákna - vezme nejstarší zachycený snímek, zakóduje ho
+     * a zapíše všechny snímky, které už jsou na řadě.
+     */
+    void EncoderLoop();
+
+    /**
+     * Převede slot na indexy palety ve výsledném rozlišení.
+     * @param slot Zachycený snímek
+     * @param pixels Výstup (width * height * pixel_scale²)
+     */
+    void RenderIndexed(const Slot& slot, std::vector<unsigned char>& pixels) const;
+
+    /**
+     * Zakóduje snímek jako obrázek GIF (řídicí blok se zpožděním, popis obrázku, LZW data).
+     * @param pixels Indexy palety
+     * @param out Výstupní buffer
+     * @param lzw_table Pracovní slovník LZW (4096 * 8 kódů)
+     */
+    void EncodeGifFrame(const std::vector<unsigned char>& pixels, std::vector<unsigned char>& out,
+                        std::vector<unsigned short>& lzw_table) const;
+
+    /**
+     * Uloží snímek jako PNG <path>_NNNNN.png.
+     * @param frame Pořadí snímku
+     * @param pixels Indexy palety
+     * @param rgba Pracovní buffer pro barvy
+     */
+    void WritePng(unsigned int frame, const std::vector<unsigned char>& pixels, std::vector<Color>& rgba) const;
+
+    /**
+     * Zapíše do GIF zakódované snímky, které jsou na řadě (nejvýš jedno vlákno naráz).
+     * @param lock Držený zámek mutex (během zápisu se uvolní)
+     */
+    void WriteEncodedFrames(std::unique_lock<std::mutex>& lock);
+};
@@ -1,8 +1,22 @@
 #include "Constants.hpp"
 
 int NUM_COLORS = 4;
+int BOARD_WIDTH = MIN_BOARD_WIDTH;
+int BOARD_HEIGHT = MIN_BOARD_HEIGHT;
 bool MUSIC_ENABLED = true;
+bool SFX_ENABLED = true;
 bool FPS_ENABLED = true;
+bool THREADED_SIMULATION = false;
+int MOVE_DAS_MS = 133;
+int MOVE_ARR_MS = 133;
+float RENDER_SCALE = 1.0f;
+int SIM_BUDGET_US = 4000;
+int ALLOC_CHECK_TICKS = 0;
 
 std::random_device rd;
 std::mt19937 gen(rd());
+
+std::string FRAME_RECORD_PATH;
+std::string CAPTURE_PATH;
+std::string SPECTATOR_PUBLISH_PATH;
+std::string SPECTATOR_VIEW_PATH;
@@ -10,14 +10,22 @@
 
 constexpr int SCREEN_WIDTH = 800;              // Šířka herního okna v pixelech
 constexpr int SCREEN_HEIGHT = 900;             // Výška herního okna v pixelech
-constexpr int BOARD_WIDTH = 10;                // Šířka desky v buňkách
-constexpr int BOARD_HEIGHT = 20;               // Výška desky v buňkách
+constexpr int MIN_BOARD_WIDTH = 10;            // Nejmenší šířka desky v buňkách (klasická)
+constexpr int MIN_BOARD_HEIGHT = 20;           // Nejmenší výška desky v buňkách (klasická)
+constexpr int MAX_BOARD_WIDTH = 100;           // Největší šířka desky v buňkách (sandbox)
+constexpr int MAX_BOARD_HEIGHT = 200;          // Největší výška desky v buňkách (sandbox)
 constexpr int PARTICLE_SIZE = 8;               // Velikost jedné částice v pixelech
 constexpr int PARTICLES_PER_BLOCK = 5;         // Počet částic na stranu buňky (5×5 = 25 částic)
 constexpr int CELL_SIZE = PARTICLE_SIZE * PARTICLES_PER_BLOCK;  // Velikost buňky (40px)
 constexpr int FPS = 60;                        // Cílový počet snímků za sekundu
+constexpr int IDLE_FPS = 20;                   // Překreslování animovaných nečinných obrazovek (menu, FPS čítač)
 constexpr int FALL_SPEED = 50;                 // Rychlost pádu tetromina (framů na posun)
-constexpr int MOVE_DELAY = 8;                  // Zpoždění pro plynulý pohyb při držení klávesy
+constexpr int SOFT_DROP_REPEAT_MS = 50;        // Opakování rychlého pádu při držení klávesy (ms)
+constexpr int MENU_REPEAT_MS = 250;            // Prodleva a opakování pohybu v menu při držení (ms)
+constexpr int INPUT_SAMPLE_MS = 2;             // Interval vzorkování vstupů mezi ticky (ms)
+constexpr int LANDING_VELOCITY = 4;            // Rychlost pádu částice, od které se dopad ozve
+constexpr int DISTURBANCE_RADIUS = 15;         // Dosah otřesu po výbuchu (v částicích)
+constexpr int GARBAGE_DIVISOR = 4;             // Souboj: soupeř dostane odstraněné částice / GARBAGE_DIVISOR písku
 const std::string GAME_NAME = "Sandtrix";        // Název hry
 const std::string GAME_VERSION = "v0.2.0";       // Verze hry
 
@@ -33,6 +41,7 @@ const Color ALL_COLORS[] = {
     {162, 155, 254, 255},  // Fialová
     {255, 107, 129, 255}   // Růžová
 };
+constexpr int PALETTE_SIZE = sizeof(ALL_COLORS) / sizeof(ALL_COLORS[0]);  // Počet barev v paletě
 
 constexpr Color BG_COLOR_TOP = {20, 20, 35, 255};       // Horní barva pozadí
 constexpr Color BG_COLOR_BOTTOM = {40, 20, 50, 255};    // Spodní barva pozadí
@@ -43,6 +52,19 @@ constexpr Color DARK_GRAY = {30, 30, 40, 255};          // Tmavě šedá pro UI
 // =============================================================================
 
 extern int NUM_COLORS;              // Počet dostupných barev (vypočítá se při běhu)
+extern int BOARD_WIDTH;             // Šířka desky v buňkách (--board, MIN_BOARD_WIDTH-MAX_BOARD_WIDTH)
+extern int BOARD_HEIGHT;            // Výška desky v buňkách (--board, MIN_BOARD_HEIGHT-MAX_BOARD_HEIGHT)
 extern bool MUSIC_ENABLED;          // Přepínač pro hudbu (nastavitelné v menu)
+extern bool SFX_ENABLED;            // Přepínač pro zvukové efekty (nastavitelné v menu)
 extern bool FPS_ENABLED;            // Přepínač pro zobrazování FPS (nastavitelné v menu)
+extern bool THREADED_SIMULATION;    // Simulace na vlastním vlákně s pevným tickem (--threaded-sim)
+extern int MOVE_DAS_MS;             // Prodleva před opakováním posunu při držení (ms, --das)
+extern int MOVE_ARR_MS;             // Interval opakování posunu (ms, 0 = na doraz, --arr)
+extern float RENDER_SCALE;          // Vnitřní rozlišení vůči SCREEN_WIDTH × SCREEN_HEIGHT (--render-scale, 1/PARTICLE_SIZE = zrno na pixel)
+extern int SIM_BUDGET_US;           // Časový rozpočet práce desky na tick (µs, 0 = bez omezení, --sim-budget)
+extern int ALLOC_CHECK_TICKS;       // Herní ticky kontroly alokací po zahřátí (--alloc-check, 0 = vypnuto)
 extern std::mt19937 gen;            // Generátor náhodných čísel
+extern std::string FRAME_RECORD_PATH;   // Záznam historie desky, každá hra s číslem před příponou (--record-frames, prázdné = vypnuto)
+extern std::string CAPTURE_PATH;        // Záznam hry do .gif, jinak předpona PNG sekvence (--capture, prázdné = vypnuto)
+extern std::string SPECTATOR_PUBLISH_PATH;  // Socket pro vysílání hry divákům (--publish, prázdné = vypnuto)
+extern std::string SPECTATOR_VIEW_PATH;     // Socket sledovaného vysílání (--spectate, prázdné = běžná hra)
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+ * Soubor z adresáře assets vložený do spustitelného souboru.
+ * Tabulku generuje premake při volbě --embed-assets
+ * (build/build_files/generated/EmbeddedAssets.cpp).
+ */
+struct EmbeddedAsset {
+    const char* name;             // Cesta relativně k assets/ (např. "music.ogg")
+    const unsigned char* data;    // Obsah souboru (jen pro čtení)
+    size_t size;                  // Velikost v bajtech
+};
+
+extern const EmbeddedAsset EMBEDDED_ASSETS[];   // Vložené soubory
+extern const int EMBEDDED_ASSET_COUNT;          // Počet vložených souborů
@@ -4,7 +4,7 @@
 #include <random>
 
 // Konstruktor - vytvoří výbuchovou částici s náhodnými parametry
-ExplosionParticle::ExplosionParticle(int x, int y, Color color)
+ExplosionParticle::ExplosionParticle(int x, int y, Color color, std::mt19937& rng)
     : x((float)x), y((float)y), color(color), age(0) {
     // Náhodná rychlost výbuchu
     std::uniform_real_distribution<> speed_dist(2.5, 6.0);
@@ -16,13 +16,13 @@ ExplosionParticle::ExplosionParticle(int x, int y, Color color)
     std::uniform_real_distribution<> angle_360(0.0, 360.0);
 
     // Inicializace náhodných hodnot
-    float speed = speed_dist(gen);
-    vx = speed * angle_dist(gen);               // Horizontální rychlost
-    vy = speed * angle_dist(gen) - jump_dist(gen); // Vertikální rychlost (výchozí nahoru)
-    lifetime = lifetime_dist(gen);              // Životnost v framech
-    size = size_dist(gen);                      // Velikost částice
-    rotation = angle_360(gen);                  // Náhodná rotace
-    rotation_speed = rot_dist(gen);             // Rychlost rotace
+    float speed = speed_dist(rng);
+    vx = speed * angle_dist(rng);               // Horizontální rychlost
+    vy = speed * angle_dist(rng) - jump_dist(rng); // Vertikální rychlost (výchozí nahoru)
+    lifetime = lifetime_dist(rng);              // Životnost v framech
+    size = size_dist(rng);                      // Velikost částice
+    rotation = angle_360(rng);                  // Náhodná rotace
+    rotation_speed = rot_dist(rng);             // Rychlost rotace
 }
 
 // Update fyziky výbuchové částice
@@ -41,7 +41,7 @@ bool ExplosionParticle::IsAlive() const {
 }
 
 // Vykreslí výbuchovou částici s fade-out efektem
-void ExplosionParticle::Draw(int offset_x, int offset_y) {
+void ExplosionParticle::Draw(int offset_x, int offset_y) const {
     // Vypočítat životní poměr (1.0 = nová, 0.0 = mrtvá)
     float life_ratio = 1.0f - (float)age / lifetime;
     unsigned char alpha = (unsigned char)(150 * life_ratio);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "raylib.h"
+#include <random>
 
 /**
  * Částice výbuchového efektu.
@@ -21,8 +22,9 @@ public:
      * @param x Počáteční x pozice
      * @param y Počáteční y pozice
      * @param color Barva částice
+     * @param rng Generátor náhody (deska, ke které částice patří)
      */
-    ExplosionParticle(int x, int y, Color color);
+    ExplosionParticle(int x, int y, Color color, std::mt19937& rng);
 
     /**
      * Aktualizuje pozici, rotaci a stárnutí částice.
@@ -41,5 +43,5 @@ public:
      * @param offset_x Horizontální offset na obrazovce
      * @param offset_y Vertikální offset na obrazovce
      */
-    void Draw(int offset_x, int offset_y);
+    void Draw(int offset_x, int offset_y) const;
 };
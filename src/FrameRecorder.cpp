@@ -0,0 +1,243 @@
+#include "FrameRecorder.hpp"
+#include "GridCodec.hpp"
+#include "Utils.hpp"
+#include "raylib.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+constexpr char STREAM_MAGIC[4] = {'S', 'T', 'R', 'F'};
+constexpr unsigned short STREAM_VERSION = 1;
+constexpr unsigned short ROW_END = 0xFFFF;          // Konec seznamu řádků v deltě
+constexpr unsigned char RECORD_KEYFRAME = 0;
+constexpr unsigned char RECORD_DELTA = 1;
+constexpr size_t RECORD_HEADER_SIZE = 4 + 1 + 4;    // tick + typ + délka dat
+}
+
+FrameRecorder::FrameRecorder(const char* path, int width, int height, int keyframe_interval, int queue_capacity)
+    : file(nullptr), width(width), height(height), keyframe_interval(std::max(1, keyframe_interval)),
+      queue_capacity(std::max(1, queue_capacity)), tick(0), last_keyframe_tick(0),
+      has_keyframe(false), dropped_frames(0), stopping(false) {
+    file = std::fopen(path, "wb");
+    if (!file) {
+        TraceLog(LOG_WARNING, "RECORDER: Failed to open %s", path);
+        return;
+    }
+
+    std::vector<unsigned char> header(STREAM_MAGIC, STREAM_MAGIC + sizeof(STREAM_MAGIC));
+    AppendValue<unsigned short>(header, STREAM_VERSION);
+    AppendValue<unsigned short>(header, (unsigned short)width);
+    AppendValue<unsigned short>(header, (unsigned short)height);
+    AppendValue<unsigned short>(header, (unsigned short)std::min(this->keyframe_interval, 0xFFFF));
+    std::fwrite(header.data(), 1, header.size(), file);
+
+    current_cells.assign(width * height, CELL_EMPTY);
+    previous_cells.assign(width * height, CELL_EMPTY);
+    changed_rows.assign(height, 0);
+    xor_row.resize(width);
+    writer = std::thread(&FrameRecorder::WriterLoop, this);
+}
+
+FrameRecorder::~FrameRecorder() {
+    if (!file) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    queue_changed.notify_one();
+    writer.join();
+    std::fclose(file);
+    if (dropped_frames > 0) {
+        TraceLog(LOG_WARNING, "RECORDER: %d frames dropped (writer too slow)", dropped_frames);
+    }
+}
+
+void FrameRecorder::RecordTick(const Board& board) {
+    if (!file) return;
+    unsigned int frame_tick = tick++;
+
+    // Vzít recyklovaný buffer, nebo snímek zahodit pokud je fronta plná
+    std::vector<unsigned char> record;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if ((int)queue.size() >= queue_capacity) {
+            dropped_frames++;
+            return;
+        }
+        if (!free_buffers.empty()) {
+            record = std::move(free_buffers.back());
+            free_buffers.pop_back();
+        }
+    }
+    record.clear();
+
+    // Obnovit jen řádky se změněnou verzí, celá deska jen poprvé
+    // nebo pokud mříž není aktuální
+    if (board.grid_dirty || (int)seen_versions.size() != height) {
+        CaptureCells(board, current_cells);
+        seen_versions = board.row_versions;
+        std::fill(changed_rows.begin(), changed_rows.end(), 1);
+    } else {
+        for (int y = 0; y < height; y++) {
+            if (board.row_versions[y] == seen_versions[y]) continue;
+            seen_versions[y] = board.row_versions[y];
+            CaptureGridRow(board, y, &current_cells[y * width]);
+            changed_rows[y] = 1;
+        }
+    }
+
+    bool keyframe = !has_keyframe || frame_tick - last_keyframe_tick >= (unsigned int)keyframe_interval;
+    AppendValue<unsigned int>(record, frame_tick);
+    AppendValue<unsigned char>(record, keyframe ? RECORD_KEYFRAME : RECORD_DELTA);
+    AppendValue<unsigned int>(record, 0); // Délka dat se doplní po zakódování
+
+    if (keyframe) {
+        for (int y = 0; y < height; y++) {
+            EncodeRowRLE(&current_cells[y * width], width, record);
+        }
+        has_keyframe = true;
+        last_keyframe_tick = frame_tick;
+        previous_cells = current_cells;
+        std::fill(changed_rows.begin(), changed_rows.end(), 0);
+    } else {
+        // Řádky změněné od posledního zapsaného snímku (i přes zahozené snímky)
+        for (int y = 0; y < height; y++) {
+            if (!changed_rows[y]) continue;
+            changed_rows[y] = 0;
+            const unsigned char* now = &current_cells[y * width];
+            unsigned char* before = &previous_cells[y * width];
+            if (std::equal(now, now + width, before)) continue;
+
+            for (int x = 0; x < width; x++) xor_row[x] = now[x] ^ before[x];
+            AppendValue<unsigned short>(record, (unsigned short)y);
+            EncodeRowRLE(xor_row.data(), width, record);
+            std::copy(now, now + width, before);
+        }
+        AppendValue<unsigned short>(record, ROW_END);
+    }
+
+    unsigned int payload_size = (unsigned int)(record.size() - RECORD_HEADER_SIZE);
+    std::memcpy(&record[5], &payload_size, sizeof(payload_size));
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push_back(std::move(record));
+    }
+    queue_changed.notify_one();
+}
+
+void FrameRecorder::WriterLoop() {
+    for (;;) {
+        std::vector<unsigned char> record;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            queue_changed.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (queue.empty()) return;
+            record = std::move(queue.front());
+            queue.pop_front();
+        }
+
+        std::fwrite(record.data(), 1, record.size(), file);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        free_buffers.push_back(std::move(record));
+    }
+}
+
+FrameStreamReader::FrameStreamReader() : width(0), height(0) {}
+
+bool FrameStreamReader::Open(const char* path) {
+    int size = 0;
+    unsigned char* file_data = LoadFileData(path, &size);
+    if (!file_data) return false;
+    data.assign(file_data, file_data + size);
+    UnloadFileData(file_data);
+    entries.clear();
+
+    constexpr size_t HEADER_SIZE = sizeof(STREAM_MAGIC) + 4 * sizeof(unsigned short);
+    if (data.size() < HEADER_SIZE || std::memcmp(data.data(), STREAM_MAGIC, sizeof(STREAM_MAGIC)) != 0) return false;
+
+    unsigned short header[4];
+    std::memcpy(header, &data[sizeof(STREAM_MAGIC)], sizeof(header));
+    if (header[0] != STREAM_VERSION) return false;
+    // Rozměry mimo meze desky odmítnout dřív, než se podle nich alokuje
+    if (!IsSupportedBoardSize(header[1], header[2])) return false;
+    width = header[1];
+    height = header[2];
+
+    // Index záznamů - neúplný záznam na konci (přerušený zápis) se ignoruje
+    size_t offset = HEADER_SIZE;
+    while (offset + RECORD_HEADER_SIZE <= data.size()) {
+        Entry entry;
+        unsigned int payload_size;
+        std::memcpy(&entry.tick, &data[offset], sizeof(entry.tick));
+        entry.keyframe = data[offset + 4] == RECORD_KEYFRAME;
+        std::memcpy(&payload_size, &data[offset + 5], sizeof(payload_size));
+        entry.offset = offset + RECORD_HEADER_SIZE;
+        entry.size = payload_size;
+        if (entry.offset + entry.size > data.size()) break;
+        entries.push_back(entry);
+        offset = entry.offset + entry.size;
+    }
+    return true;
+}
+
+int FrameStreamReader::GetLastTick() const {
+    return entries.empty() ? -1 : (int)entries.back().tick;
+}
+
+bool FrameStreamReader::Seek(int target_tick, std::vector<unsigned char>& cells) const {
+    // Poslední záznam s tickem <= cíl
+    auto after = std::upper_bound(entries.begin(), entries.end(), (unsigned int)std::max(0, target_tick),
+                                  [](unsigned int t, const Entry& e) { return t < e.tick; });
+    if (target_tick < 0 || after == entries.begin()) return false;
+
+    // Nejbližší předchozí klíčový snímek
+    auto key = after - 1;
+    while (!key->keyframe) {
+        if (key == entries.begin()) return false;
+        --key;
+    }
+
+    cells.resize(width * height);
+    std::vector<unsigned char> row(width);
+    for (auto it = key; it != after; ++it) {
+        const unsigned char* cursor = &data[it->offset];
+        const unsigned char* end = cursor + it->size;
+
+        if (it->keyframe) {
+            for (int y = 0; y < height; y++) {
+                cursor = DecodeRowRLE(cursor, end, &cells[y * width], width);
+                if (!cursor) return false;
+            }
+            continue;
+        }
+
+        for (;;) {
+            unsigned short y;
+            if (end - cursor < (int)sizeof(y)) return false;
+            std::memcpy(&y, cursor, sizeof(y));
+            cursor += sizeof(y);
+            if (y == ROW_END) break;
+            if (y >= height) return false;
+
+            cursor = DecodeRowRLE(cursor, end, row.data(), width);
+            if (!cursor) return false;
+            for (int x = 0; x < width; x++) cells[y * width + x] ^= row[x];
+        }
+    }
+    return true;
+}
+
+bool FrameStreamReader::ExportTick(int target_tick, const char* image_path) const {
+    std::vector<unsigned char> cells;
+    if (!Seek(target_tick, cells)) return false;
+
+    // 1 pixel = 1 buňka částic, prázdné buňky průhledné
+    std::vector<Color> pixels(cells.size(), BLANK);
+    for (size_t i = 0; i < cells.size(); i++) {
+        if (cells[i] != CELL_EMPTY) pixels[i] = CellColor(cells[i]);
+    }
+    Image image = {pixels.data(), width, height, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8};
+    return ExportImage(image, image_path);
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "Board.hpp"
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Záznam kompletní historie desky po jednotlivých ticích.
+ *
+ * Formát souboru (verze 1): hlavička "STRF" + verze, šířka, výška
+ * a interval klíčových snímků, pak záznamy {tick, typ, délka, data}.
+ * - Klíčový snímek: všechny řádky desky v RLE (viz GridCodec.hpp)
+ * - Delta: jen změněné řádky jako {index řádku, RLE XOR proti
+ *   předchozímu zapsanému snímku}, zakončeno indexem 0xFFFF
+ * Klidný tick bez změn tak zabere jen hlavičku záznamu.
+ *
+ * Kódování běží v herní smyčce, zápis na disk v samostatném vlákně
+ * přes omezenou frontu. Při plné frontě se snímek zahodí (počítá se),
+ * další delta se pak vztahuje k poslednímu zapsanému snímku.
+ */
+class FrameRecorder {
+public:
+    /**
+     * Konstruktor - otevře soubor a spustí zapisovací vlákno.
+     * @param path Cesta k výstupnímu souboru
+     * @param width Šířka desky v buňkách částic
+     * @param height Výška desky v buňkách částic
+     * @param keyframe_interval Počet ticků mezi klíčovými snímky
+     * @param queue_capacity Maximální počet snímků čekajících na zápis
+     */
+    FrameRecorder(const char* path, int width, int height, int keyframe_interval = 600, int queue_capacity = 64);
+
+    /**
+     * Destruktor - zapíše zbytek fronty a ukončí vlákno.
+     */
+    ~FrameRecorder();
+
+    FrameRecorder(const FrameRecorder&) = delete;
+    FrameRecorder& operator=(const FrameRecorder&) = delete;
+
+    /**
+     * @return true pokud se soubor podařilo otevřít
+     */
+    bool IsOpen() const { return file != nullptr; }
+
+    /**
+     * Zaznamená aktuální stav desky. Nikdy neblokuje na disku.
+     * @param board Deska (musí mít rozměry zadané v konstruktoru)
+     */
+    void RecordTick(const Board& board);
+
+    /**
+     * @return Počet snímků zahozených kvůli plné frontě
+     */
+    int GetDroppedFrames() const { return dropped_frames; }
+
+private:
+    std::FILE* file;                                   // Výstupní soubor (používá jen zapisovací vlákno)
+    int width, height;                                 // Rozměry desky
+    int keyframe_interval;                             // Ticky mezi klíčovými snímky
+    int queue_capacity;                                // Kapacita fronty
+    unsigned int tick;                                 // Aktuální tick záznamu
+    unsigned int last_keyframe_tick;                   // Tick posledního zapsaného klíčového snímku
+    bool has_keyframe;                                 // Byl už zapsán aspoň jeden klíčový snímek
+    int dropped_frames;                                // Počet zahozených snímků
+
+    std::vector<unsigned char> current_cells;          // Zachycený aktuální stav
+    std::vector<unsigned char> previous_cells;         // Poslední zapsaný stav (základ delty)
+    std::vector<unsigned int> seen_versions;           // Verze řádků desky odpovídající current_cells
+    std::vector<unsigned char> changed_rows;           // Řádky změněné od posledního zapsaného snímku
+    std::vector<unsigned char> xor_row;                // Pracovní řádek pro XOR
+
+    std::deque<std::vector<unsigned char>> queue;      // Zakódované záznamy čekající na zápis
+    std::vector<std::vector<unsigned char>> free_buffers;  // Recyklované buffery záznamů
+    std::mutex mutex;                                  // Zámek fronty
+    std::condition_variable queue_changed;             // Signál nového záznamu / ukončení
+    bool stopping;                                     // Příznak ukončení vlákna
+    std::thread writer;                                // Zapisovací vlákno
+
+    /**
+     * Smyčka zapisovacího vlákna.
+     */
+    void WriterLoop();
+};
+
+/**
+ * Čtečka záznamu z FrameRecorder - umí přejít na libovolný tick.
+ * Při otevření si vytvoří index záznamů, přechod na tick pak dekóduje
+ * nejbližší předchozí klíčový snímek a aplikuje delty až k cíli.
+ */
+class FrameStreamReader {
+public:
+    int width, height;  // Rozměry desky v záznamu
+
+    FrameStreamReader();
+
+    /**
+     * Načte soubor záznamu a vytvoří index.
+     * @param path Cesta k souboru
+     * @return false pokud soubor chybí nebo má neplatnou hlavičku (i rozměry mimo meze desky)
+     */
+    bool Open(const char* path);
+
+    /**
+     * @return Tick posledního záznamu v souboru (-1 pokud je prázdný)
+     */
+    int GetLastTick() const;
+
+    /**
+     * Zrekonstruuje desku v daném ticku.
+     * @param target_tick Cílový tick
+     * @param cells Výstupní kódy buněk (width * height)
+     * @return false pokud tick leží před prvním klíčovým snímkem nebo jsou data poškozená
+     */
+    bool Seek(int target_tick, std::vector<unsigned char>& cells) const;
+
+    /**
+     * Uloží desku v daném ticku jako obrázek (1 pixel = 1 buňka částic).
+     * @param target_tick Cílový tick
+     * @param image_path Výstupní obrázek (formát podle přípony, např. .png)
+     * @return false pokud tick nejde zrekonstruovat nebo zápis selhal
+     */
+    bool ExportTick(int target_tick, const char* image_path) const;
+
+private:
+    /**
+     * Položka indexu - jeden záznam v souboru.
+     */
+    struct Entry {
+        unsigned int tick;
+        bool keyframe;
+        size_t offset, size;
+    };
+
+    std::vector<unsigned char> data;   // Celý obsah souboru
+    std::vector<Entry> entries;        // Index záznamů v pořadí ticků
+};
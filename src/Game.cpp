@@ -1,21 +1,110 @@
 #include "Game.hpp"
 #include "Constants.hpp"
 #include "Utils.hpp"
+#include "GrainAtlas.hpp"
 #include "Shapes.hpp"
+#include "GridCodec.hpp"
+#include "Snapshot.hpp"
+#include "AllocationCounter.hpp"
 #include <cmath>
+#include <cstdarg>
+#include <cstdio>
+#include <sstream>
+
+namespace {
+// Herní ticky po startu kontroly alokací, kdy se paměť ještě může alokovat
+// (první tahy bota, růst pracovních seznamů na skutečnou velikost)
+constexpr int ALLOC_CHECK_WARMUP_TICKS = 600;
+
+// Převod tetromina na uložitelný stav a zpět (uložená hra, přetáčení)
+PieceSnapshot MakePieceSnapshot(const Tetromino* t) {
+    return PieceSnapshot{t->shape_type, t->rotation, std::max(0, GetColorIndex(t->color)),
+                         t->board_x, t->board_y, t->is_active};
+}
+
+void ApplyPieceSnapshot(Tetromino* t, const PieceSnapshot& piece) {
+    t->shape_type = piece.shape_type;
+    t->rotation = piece.rotation;
+    t->color = ALL_COLORS[std::min(piece.color_index, PALETTE_SIZE - 1)];
+    t->board_x = piece.board_x;
+    t->board_y = piece.board_y;
+    t->is_active = piece.is_active;
+    t->GenerateParticles();
+}
+
+// Snímek hrací plochy hráče souboje
+void CaptureVersusPlayer(VersusPlayer& player, PlayerFrame& frame) {
+    frame.has_board = true;
+    player.board->CaptureFrame(frame.board);
+
+    frame.current_piece.clear();
+    if (player.current_tetromino && player.current_tetromino->is_active) {
+        frame.current_piece = player.current_tetromino->particles;
+    }
+
+    frame.has_next = true;
+    frame.next_shape = player.next_tetromino->shape_type;
+    frame.next_color = player.next_tetromino->color;
+    frame.score = player.score;
+    frame.game_over = player.game_over;
+    frame.garbage = player.garbage_in;
+}
+
+// Svislý gradient kreslený po řádcích obrazovky
+void DrawGradientLines(Color top, Color bottom) {
+    for (int y = 0; y < SCREEN_HEIGHT; y++) {
+        float blend = (float)y / SCREEN_HEIGHT;
+        Color c = BlendColors(top, bottom, blend);
+        DrawLine(0, y, SCREEN_WIDTH, y, c);
+    }
+}
+}
 
 // Konstruktor - inicializace hry
-Game::Game() : state(INTRO_SCREEN), board(nullptr), current_tetromino(nullptr),
-         next_tetromino(nullptr), score(0), game_over(false), fall_counter(0),
+Game::Game() : state(INTRO_SCREEN), mode(GameMode::NORMAL), board(nullptr), current_tetromino(nullptr),
+         next_tetromino(nullptr), versus(nullptr), thread_pool(nullptr), bot(nullptr),
+         bot_target{0, 0, 0.0f, false}, bot_has_target(false), frame_recorder(nullptr),
+         recorded_games(0), clip_recorder(nullptr),
+         rewind_buffer(nullptr), rewinding(false), spectator_publisher(nullptr),
+         spectator_client(nullptr), spectator_retry_counter(0), audio_thread(nullptr),
+         sfx_mixer(nullptr), assets(nullptr), startup_time(std::chrono::steady_clock::now()),
+         explosion_group_size(0), landing_cooldown(0), score(0), game_over(false), fall_counter(0),
          current_fall_speed(FALL_SPEED), waiting_for_settlement(false),
-         offset_x(50), offset_y(50), move_counter_left(0), move_counter_right(0),
-         move_counter_down(0), main_menu_selected(0), settings_menu_selected(0),
+         board_camera(), board_viewport(), camera_zoom(1.0f), camera_center{0, 0},
+         camera_follow(true), camera_changed(false), main_menu_selected(0), settings_menu_selected(0),
          pause_menu_selected(0), intro(nullptr), should_exit(false),
-         active_gamepad(-1), gamepad_menu_delay(0),
-         gamepad_move_delay_left(0), gamepad_move_delay_right(0) {
+         active_gamepad(-1), has_saved_game(false), board_width_setting(BOARD_WIDTH),
+         board_height_setting(BOARD_HEIGHT),
+         main_menu_label_count(0), menu_labels_valid(false), background_texture(),
+         background_top(BLACK), background_bottom(BLACK), frozen_frame(), frozen_frame_valid(false),
+         canvas(), canvas_scale(1.0f), canvas_dest{0, 0, (float)SCREEN_WIDTH, (float)SCREEN_HEIGHT},
+         frames_since_draw(-1), frame_allocation_mark(0), frame_allocations(0), alloc_check_tick(0),
+         alloc_check_count(0), alloc_check_failed(false), simulation(nullptr), drawn_particle_count(0),
+         update_graph(nullptr), connections_removed(0) {
     // Vytvořit úvodní animaci
     intro = new Intro(GAME_NAME.c_str(), SCREEN_WIDTH, SCREEN_HEIGHT);
 
+    // Pracovní vlákna a bot pro automatickou hru
+    thread_pool = new ThreadPool();
+    bot = new Bot(*thread_pool);
+    BuildUpdateGraph();
+
+    LayoutBoard();
+
+    // Levý hráč souboje hraje na WASD, pravý na šipkách
+    versus_inputs[0].SetKeyboardKeys(KeyboardKeys::WASD);
+
+    // Uložená hra leží vedle spustitelného souboru, nezávisle na pracovním adresáři
+    save_path = std::string(GetApplicationDirectory()) + "sandtrix.sav";
+    has_saved_game = FileExists(save_path.c_str());
+
+    // Vysílání pro diváky (zapne se volbou --publish), běží přes všechny hry
+    if (!SPECTATOR_PUBLISH_PATH.empty()) {
+        spectator_publisher = new SpectatorPublisher(SPECTATOR_PUBLISH_PATH.c_str(),
+                                                     BOARD_WIDTH * PARTICLES_PER_BLOCK,
+                                                     BOARD_HEIGHT * PARTICLES_PER_BLOCK);
+    }
+
     // Detekce připojeného gamepadu při startu (max 4 gamepady)
     for (int i = 0; i < 4; i++) {
         if (IsGamepadAvailable(i)) {
@@ -30,20 +119,59 @@ Game::~Game() {
     if (board) delete board;
     if (current_tetromino) delete current_tetromino;
     if (next_tetromino) delete next_tetromino;
+    if (versus) delete versus;
     if (intro) delete intro;
+    if (bot) delete bot;
+    if (thread_pool) delete thread_pool;
+    if (frame_recorder) delete frame_recorder;
+    if (clip_recorder) delete clip_recorder;
+    if (rewind_buffer) delete rewind_buffer;
+    if (spectator_publisher) delete spectator_publisher;
+    if (spectator_client) delete spectator_client;
+    if (simulation) delete simulation;
+    if (update_graph) delete update_graph;
 }
 
 // Spustit novou hru - reset všech herních hodnot
-void Game::NewGame() {
+void Game::NewGame(GameMode new_mode, int board_width, int board_height) {
+    // Rozměr desky této hry - jiný než --board má jen pokračování uložené hry,
+    // každá další hra se vrací k nastavenému
+    BOARD_WIDTH = (board_width > 0) ? board_width : board_width_setting;
+    BOARD_HEIGHT = (board_height > 0) ? board_height : board_height_setting;
+
     // Smazat staré objekty pokud existují
     if (board) delete board;
     if (current_tetromino) delete current_tetromino;
     if (next_tetromino) delete next_tetromino;
+    if (versus) delete versus;
+    versus = nullptr;
 
-    // Vytvořit nové herní objekty
-    board = new Board();
+    // Vytvořit nové herní objekty (souboj má desky a kostky obou hráčů ve Versus)
+    board = nullptr;
     current_tetromino = nullptr;
-    next_tetromino = new Tetromino(0, 0);
+    next_tetromino = nullptr;
+    if (new_mode == GameMode::VERSUS) {
+        versus = new Versus(*thread_pool, gen());
+    } else {
+        board = new Board();
+        next_tetromino = new Tetromino(0, 0, gen);
+    }
+
+    // Záznam historie desky (zapne se volbou --record-frames)
+    if (frame_recorder) delete frame_recorder;
+    frame_recorder = nullptr;
+    if (!FRAME_RECORD_PATH.empty() && board) {
+        // Každá hra do vlastního číslovaného souboru (hra-001.bin, ...),
+        // záznam tak může běžet celou relaci bez přepsání předchozích her
+        std::string path = FRAME_RECORD_PATH;
+        size_t dot = path.find_last_of('.');
+        size_t slash = path.find_last_of("/\\");
+        if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) dot = path.size();
+        char number[16];
+        std::snprintf(number, sizeof(number), "-%03d", ++recorded_games);
+        path.insert(dot, number);
+        frame_recorder = new FrameRecorder(path.c_str(), board->width, board->height);
+    }
 
     // Reset herního stavu
     score = 0;
@@ -51,21 +179,35 @@ void Game::NewGame() {
     fall_counter = 0;
     current_fall_speed = FALL_SPEED;
     waiting_for_settlement = false;
-    move_counter_left = 0;
-    move_counter_right = 0;
-    move_counter_down = 0;
+    mode = new_mode;
+    bot_has_target = false;
+    rewinding = false;
+    LayoutBoard();
 
     // Spawn prvního tetromina a přejít do herního stavu
-    SpawnTetromino();
+    if (board) SpawnTetromino();
     state = PLAYING;
+
+    // Nová deska - divákům se pošlou všechny odlišné řádky
+    if (spectator_publisher) spectator_publisher->Resync();
+
+    // Historie pro přetáčení jen v tréninku
+    if (rewind_buffer) delete rewind_buffer;
+    rewind_buffer = nullptr;
+    if (mode == GameMode::PRACTICE) {
+        // Velká deska mění víc řádků za tick - blok záznamů roste s plochou desky
+        size_t capacity = std::max<size_t>(4 * 1024 * 1024, (size_t)board->width * board->height * 16);
+        rewind_buffer = new RewindBuffer(board->width, board->height, 600, capacity);
+        rewind_buffer->Reset(*board, GetRewindState());
+    }
 }
 
 // Vytvořit nové tetromino na vrcholu desky
 void Game::SpawnTetromino() {
-    if (current_tetromino) delete current_tetromino;
-
-    // Vytvořit tetromino na středu desky (x), na vrcholu (y = 0)
-    current_tetromino = new Tetromino(BOARD_WIDTH / 2 - 2, 0);
+    // Tetromino na středu desky (x), na vrcholu (y = 0) - objekty kostek
+    // se znovu používají, spawn během hry nealokuje
+    if (current_tetromino) current_tetromino->Reset(BOARD_WIDTH / 2 - 2, 0, gen);
+    else current_tetromino = new Tetromino(BOARD_WIDTH / 2 - 2, 0, gen);
 
     // Zkopírovat tvar a barvu z next_tetromino (preview)
     if (next_tetromino) {
@@ -74,17 +216,230 @@ void Game::SpawnTetromino() {
         current_tetromino->rotation = 0;
         current_tetromino->GenerateParticles();
 
-        // Vytvořit nové next_tetromino
-        delete next_tetromino;
-        next_tetromino = new Tetromino(0, 0);
+        // Nové next_tetromino
+        next_tetromino->Reset(0, 0, gen);
     }
 
+    // Bot rozhoduje znovu pro každou novou kostku
+    bot_has_target = false;
+
     // Kontrola game over - pokud nové tetromino koliduje hned při spawnu
     if (board->CheckCollision(current_tetromino->particles)) {
         game_over = true;
+        if (mode == GameMode::NORMAL) DeleteSavedGame();
     }
 }
 
+void Game::SaveGame() {
+    if (!board || game_over || mode != GameMode::NORMAL) return;
+
+    GameSnapshot snapshot;
+    snapshot.width = board->width;
+    snapshot.height = board->height;
+    CaptureCells(*board, snapshot.cells);
+
+    // Rychlosti neusazených částic ve stejném pořadí, v jakém je obnoví LoadSavedGame
+    std::vector<int> velocity_grid(board->width * board->height, 0);
+    for (auto p : board->particles) {
+        int px = (int)p->x;
+        int py = (int)p->y;
+        if (px >= 0 && px < board->width && py >= 0 && py < board->height) {
+            velocity_grid[py * board->width + px] = p->velocity_y;
+        }
+    }
+    for (size_t i = 0; i < snapshot.cells.size(); i++) {
+        if (snapshot.cells[i] != CELL_EMPTY && !(snapshot.cells[i] & CELL_SETTLED)) {
+            snapshot.velocities.push_back((signed char)std::max(-128, std::min(127, velocity_grid[i])));
+        }
+    }
+
+    snapshot.current = MakePieceSnapshot(current_tetromino);
+    snapshot.next = MakePieceSnapshot(next_tetromino);
+    snapshot.score = score;
+    snapshot.fall_speed = current_fall_speed;
+    snapshot.fall_counter = fall_counter;
+    snapshot.num_colors = NUM_COLORS;
+    snapshot.waiting_for_settlement = waiting_for_settlement;
+
+    std::ostringstream rng_stream;
+    rng_stream << gen;
+    snapshot.rng_state = rng_stream.str();
+    std::ostringstream board_rng_stream;
+    board_rng_stream << board->rng;
+    snapshot.board_rng_state = board_rng_stream.str();
+
+    if (SaveGameSnapshot(save_path.c_str(), snapshot)) {
+        has_saved_game = true;
+    } else {
+        TraceLog(LOG_WARNING, "SAVE: Failed to write %s", save_path.c_str());
+    }
+}
+
+bool Game::LoadSavedGame() {
+    GameSnapshot snapshot;
+    if (!LoadGameSnapshot(save_path.c_str(), snapshot)) {
+        TraceLog(LOG_WARNING, "SAVE: Failed to load %s", save_path.c_str());
+        DeleteSavedGame();
+        return false;
+    }
+
+    // Hra pokračuje na rozměru uložené desky (mohla vzniknout s jiným --board);
+    // rozměr, který tato verze neumí, se nenačte, soubor ale zůstane
+    if (!IsSupportedBoardSize(snapshot.width, snapshot.height)) {
+        TraceLog(LOG_WARNING, "SAVE: Unsupported board size %dx%d", snapshot.width, snapshot.height);
+        return false;
+    }
+
+    // NewGame vytvoří desku uloženého rozměru a rozvrhne ji na obrazovce;
+    // nastavení --board zůstává pro další hry
+    NUM_COLORS = snapshot.num_colors;
+    NewGame(GameMode::NORMAL, snapshot.width / PARTICLES_PER_BLOCK, snapshot.height / PARTICLES_PER_BLOCK);
+
+    RestoreBoardFromCells(*board, snapshot.cells.data());
+    size_t velocity_index = 0;
+    for (auto p : board->particles) {
+        if (!p->settled && velocity_index < snapshot.velocities.size()) {
+            p->velocity_y = snapshot.velocities[velocity_index++];
+        }
+    }
+
+    ApplyPieceSnapshot(current_tetromino, snapshot.current);
+    ApplyPieceSnapshot(next_tetromino, snapshot.next);
+
+    score = snapshot.score;
+    current_fall_speed = snapshot.fall_speed;
+    fall_counter = snapshot.fall_counter;
+    waiting_for_settlement = snapshot.waiting_for_settlement;
+    game_over = false;
+
+    // Stav RNG až nakonec - NewGame a tetromina ho mezitím posunuly
+    std::istringstream rng_stream(snapshot.rng_state);
+    rng_stream >> gen;
+    // Starší uložení (verze 1) stav RNG desky nemají
+    if (!snapshot.board_rng_state.empty()) {
+        std::istringstream board_rng_stream(snapshot.board_rng_state);
+        board_rng_stream >> board->rng;
+    }
+    return true;
+}
+
+void Game::DeleteSavedGame() {
+    std::remove(save_path.c_str());
+    has_saved_game = false;
+}
+
+RewindState Game::GetRewindState() const {
+    return RewindState{MakePieceSnapshot(current_tetromino), MakePieceSnapshot(next_tetromino),
+                       score, current_fall_speed, fall_counter, waiting_for_settlement};
+}
+
+void Game::ApplyRewindState(const RewindState& rewind_state) {
+    ApplyPieceSnapshot(current_tetromino, rewind_state.current);
+    ApplyPieceSnapshot(next_tetromino, rewind_state.next);
+    score = rewind_state.score;
+    current_fall_speed = rewind_state.fall_speed;
+    fall_counter = rewind_state.fall_counter;
+    waiting_for_settlement = rewind_state.waiting_for_settlement;
+}
+
+void Game::UpdateRewind() {
+    RewindState rewind_state;
+    if (!rewind_buffer->StepBack(rewind_state)) return;
+
+    rewind_buffer->Restore(*board);
+    ApplyRewindState(rewind_state);
+    game_over = false; // Přetočením lze vrátit i konec hry
+}
+
+void Game::StartAudio() {
+    double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startup_time).count();
+    TraceLog(LOG_INFO, "STARTUP: Assets ready after %.1f ms", elapsed);
+
+    sfx_mixer = new SfxMixer(assets->sfx_pcm);
+    audio_thread = new AudioThread(assets->music_data, assets->music_size, MUSIC_ENABLED);
+}
+
+void Game::PlaySfx(SfxId id, float intensity) {
+    if (sfx_mixer && SFX_ENABLED) sfx_mixer->Play(id, intensity);
+}
+
+void Game::PublishSpectatorFrame() {
+    SpectatorState spectator_state;
+    spectator_state.current = MakePieceSnapshot(current_tetromino);
+    spectator_state.next = MakePieceSnapshot(next_tetromino);
+    spectator_state.score = score;
+    spectator_state.num_colors = NUM_COLORS;
+    spectator_state.game_over = game_over;
+    spectator_publisher->PublishTick(*board, spectator_state);
+}
+
+void Game::StartSpectating() {
+    spectator_client = new SpectatorClient();
+    spectator_client->state.num_colors = NUM_COLORS;  // Do prvního snímku vysílání
+    board = new Board();
+    current_tetromino = new Tetromino(0, 0, gen);
+    current_tetromino->is_active = false;
+    next_tetromino = new Tetromino(0, 0, gen);
+    spectator_retry_counter = 0;
+    state = SPECTATING;
+}
+
+void Game::UpdateSpectator() {
+    board->UpdateShake();
+
+    // Vysílání ještě neběží nebo skončilo - zkoušet se připojit jednou za sekundu
+    if (!spectator_client->IsConnected()) {
+        if (spectator_retry_counter-- > 0) return;
+        spectator_retry_counter = FPS;
+        if (!spectator_client->Connect(SPECTATOR_VIEW_PATH.c_str())) return;
+    }
+
+    if (spectator_client->Poll() == 0) return;
+
+    // Vysílající může hrát na jiném rozměru desky (--board) - deska diváka se mu
+    // přizpůsobí; nastavení --board zůstává, případná další hra (NewGame) ho obnoví
+    if (spectator_client->width != board->width || spectator_client->height != board->height) {
+        if (!IsSupportedBoardSize(spectator_client->width, spectator_client->height)) return;
+        BOARD_WIDTH = spectator_client->width / PARTICLES_PER_BLOCK;
+        BOARD_HEIGHT = spectator_client->height / PARTICLES_PER_BLOCK;
+        delete board;
+        board = new Board();
+        LayoutBoard();
+        spectator_client->board_changed = true;
+    }
+
+    if (spectator_client->board_changed) {
+        RestoreBoardFromCells(*board, spectator_client->cells.data());
+        spectator_client->board_changed = false;
+    }
+
+    const SpectatorState& stream_state = spectator_client->state;
+    ApplyPieceSnapshot(current_tetromino, stream_state.current);
+    ApplyPieceSnapshot(next_tetromino, stream_state.next);
+    score = stream_state.score;
+    game_over = stream_state.game_over;
+
+    // Výbuchy se jen naznačí bleskem barvy skupiny a otřesem úměrným velikosti
+    for (const ExplosionEvent& event : spectator_client->events) {
+        board->explosion_flash_color = ALL_COLORS[std::min(event.color_index, PALETTE_SIZE - 1)];
+        board->TriggerShake(std::min(30, 5 + event.grains / 20));
+        PlaySfx(SfxId::EXPLOSION, std::min(1.0f, event.grains / 1500.0f));
+    }
+    spectator_client->events.clear();
+}
+
+int Game::GetMainMenuItems(MainMenuItem* items) const {
+    int count = 0;
+    if (has_saved_game) items[count++] = MainMenuItem::CONTINUE;
+    items[count++] = MainMenuItem::NEW_GAME;
+    items[count++] = MainMenuItem::PRACTICE;
+    items[count++] = MainMenuItem::AUTOPLAY;
+    items[count++] = MainMenuItem::VERSUS;
+    items[count++] = MainMenuItem::SETTINGS;
+    items[count++] = MainMenuItem::EXIT;
+    return count;
+}
+
 void Game::UpdateGamepad() {
     // Zkontroluj, jestli je aktivní gamepad stále připojen
     if (active_gamepad >= 0 && !IsGamepadAvailable(active_gamepad)) {
@@ -100,98 +455,62 @@ void Game::UpdateGamepad() {
             }
         }
     }
+    input.SetGamepad(active_gamepad);
+
+    // V souboji má každý hráč svůj gamepad podle pořadí připojení
+    for (int i = 0; i < 2; i++) {
+        versus_inputs[i].SetGamepad(IsGamepadAvailable(i) ? i : -1);
+    }
 }
 
 void Game::HandleInput() {
     if (state == INTRO_SCREEN) {
-        bool skip = IsKeyPressed(KEY_ENTER) || IsKeyPressed(KEY_SPACE) || IsKeyPressed(KEY_ESCAPE);
-
-        // Gamepad: A button pro skip
-        if (active_gamepad >= 0) {
-            skip = skip || IsGamepadButtonPressed(active_gamepad, GAMEPAD_BUTTON_RIGHT_FACE_DOWN); // A button
-        }
-
-        if (skip) {
+        if (input.IsPressed(InputAction::SKIP)) {
             state = MAIN_MENU;
         }
+    } else if (state == SPECTATING) {
+        // Divák jen sleduje - ESC ukončí aplikaci
+        if (input.IsPressed(InputAction::PAUSE)) should_exit = true;
     } else if (state == MAIN_MENU) {
-        bool up = IsKeyPressed(KEY_UP);
-        bool down = IsKeyPressed(KEY_DOWN);
-        bool enter = IsKeyPressed(KEY_ENTER);
-
-        // Gamepad: levá páčka nebo D-pad pro navigaci
-        if (active_gamepad >= 0) {
-            float axis_y = GetGamepadAxisMovement(active_gamepad, GAMEPAD_AXIS_LEFT_Y);
-            bool dpad_up = IsGamepadButtonPressed(active_gamepad, GAMEPAD_BUTTON_LEFT_FACE_UP);
-            bool dpad_down = IsGamepadButtonPressed(active_gamepad, GAMEPAD_BUTTON_LEFT_FACE_DOWN);
-
-            // Delay pro páčku aby se necyklovala moc rychle
-            if (gamepad_menu_delay == 0) {
-                if (axis_y < -0.5f || dpad_up) {
-                    up = true;
-                    gamepad_menu_delay = 15;
-                } else if (axis_y > 0.5f || dpad_down) {
-                    down = true;
-                    gamepad_menu_delay = 15;
-                }
-            } else {
-                gamepad_menu_delay--;
-            }
+        // Držení šipky / páčky opakuje pohyb v menu
+        int up = input.GetRepeatSteps(InputAction::MENU_UP, MENU_REPEAT_MS, MENU_REPEAT_MS, 1);
+        int down = input.GetRepeatSteps(InputAction::MENU_DOWN, MENU_REPEAT_MS, MENU_REPEAT_MS, 1);
+        bool enter = input.IsPressed(InputAction::CONFIRM);
 
-            enter = enter || IsGamepadButtonPressed(active_gamepad, GAMEPAD_BUTTON_RIGHT_FACE_DOWN); // A button
-        }
+        MainMenuItem items[7];
+        int item_count = GetMainMenuItems(items);
+        if (main_menu_selected >= item_count) main_menu_selected = 0;
 
-        if (up) {
-            main_menu_selected = (main_menu_selected - 1 + 3) % 3;
-        }
-        if (down) {
-            main_menu_selected = (main_menu_selected + 1) % 3;
-        }
+        main_menu_selected = ((main_menu_selected - up + down) % item_count + item_count) % item_count;
         if (enter) {
-            if (main_menu_selected == 0) NewGame();
-            else if (main_menu_selected == 1) state = SETTINGS;
-            else should_exit = true;
-        }
-    } else if (state == SETTINGS) {
-        bool up = IsKeyPressed(KEY_UP);
-        bool down = IsKeyPressed(KEY_DOWN);
-        bool enter = IsKeyPressed(KEY_ENTER);
-        bool escape = IsKeyPressed(KEY_ESCAPE);
-
-        // Gamepad: levá páčka nebo D-pad pro navigaci
-        if (active_gamepad >= 0) {
-            float axis_y = GetGamepadAxisMovement(active_gamepad, GAMEPAD_AXIS_LEFT_Y);
-            bool dpad_up = IsGamepadButtonPressed(active_gamepad, GAMEPAD_BUTTON_LEFT_FACE_UP);
-            bool dpad_down = IsGamepadButtonPressed(active_gamepad, GAMEPAD_BUTTON_LEFT_FACE_DOWN);
-
-            if (gamepad_menu_delay == 0) {
-                if (axis_y < -0.5f || dpad_up) {
-                    up = true;
-                    gamepad_menu_delay = 15;
-                } else if (axis_y > 0.5f || dpad_down) {
-                    down = true;
-                    gamepad_menu_delay = 15;
-                }
-            } else {
-                gamepad_menu_delay--;
+            switch (items[main_menu_selected]) {
+                case MainMenuItem::CONTINUE:
+                    if (!LoadSavedGame()) main_menu_selected = 0;
+                    break;
+                case MainMenuItem::NEW_GAME: NewGame(); break;
+                case MainMenuItem::PRACTICE: NewGame(GameMode::PRACTICE); break;
+                case MainMenuItem::AUTOPLAY: NewGame(GameMode::AUTOPLAY); break;
+                case MainMenuItem::VERSUS: NewGame(GameMode::VERSUS); break;
+                case MainMenuItem::SETTINGS: state = SETTINGS; break;
+                case MainMenuItem::EXIT: should_exit = true; break;
             }
-
-            enter = enter || IsGamepadButtonPressed(active_gamepad, GAMEPAD_BUTTON_RIGHT_FACE_DOWN); // A button
-            escape = escape || IsGamepadButtonPressed(active_gamepad, GAMEPAD_BUTTON_RIGHT_FACE_RIGHT); // B button
         }
+    } else if (state == SETTINGS) {
+        int up = input.GetRepeatSteps(InputAction::MENU_UP, MENU_REPEAT_MS, MENU_REPEAT_MS, 1);
+        int down = input.GetRepeatSteps(InputAction::MENU_DOWN, MENU_REPEAT_MS, MENU_REPEAT_MS, 1);
+        bool enter = input.IsPressed(InputAction::CONFIRM);
+        bool escape = input.IsPressed(InputAction::BACK);
 
-        if (up) {
-            settings_menu_selected = (settings_menu_selected - 1 + 7) % 7;
-        }
-        if (down) {
-            settings_menu_selected = (settings_menu_selected + 1) % 7;
-        }
+        settings_menu_selected = ((settings_menu_selected - up + down) % 8 + 8) % 8;
         if (enter) {
             if (settings_menu_selected == 3) {
                 MUSIC_ENABLED = !MUSIC_ENABLED;
+                if (audio_thread) audio_thread->SetMusicEnabled(MUSIC_ENABLED);
             } else if (settings_menu_selected == 4) {
-                FPS_ENABLED = !FPS_ENABLED;
+                SFX_ENABLED = !SFX_ENABLED;
             } else if (settings_menu_selected == 5) {
+                FPS_ENABLED = !FPS_ENABLED;
+            } else if (settings_menu_selected == 6) {
                 // Výběr gamepadu - přepne na další dostupný
                 int next_gamepad = (active_gamepad + 1) % 4;
                 for (int i = 0; i < 4; i++) {
@@ -201,14 +520,10 @@ void Game::HandleInput() {
                     }
                     next_gamepad = (next_gamepad + 1) % 4;
                 }
-            } else if (settings_menu_selected == 6) {
-                // Přepnutí jazyka
-                Language current = localization.GetLanguage();
-                if (current == Language::ENGLISH) {
-                    localization.SetLanguage(Language::CZECH);
-                } else {
-                    localization.SetLanguage(Language::ENGLISH);
-                }
+                input.SetGamepad(active_gamepad);
+            } else if (settings_menu_selected == 7) {
+                // Přepnutí jazyka (cyklicky přes všechny jazyky)
+                localization.SetLanguage(localization.GetNextLanguage());
             } else {
                 int colors[] = {3, 4, 6};
                 NUM_COLORS = colors[settings_menu_selected];
@@ -219,39 +534,12 @@ void Game::HandleInput() {
             state = MAIN_MENU;
         }
     } else if (state == PAUSED) {
-        bool up = IsKeyPressed(KEY_UP);
-        bool down = IsKeyPressed(KEY_DOWN);
-        bool enter = IsKeyPressed(KEY_ENTER);
-        bool escape = IsKeyPressed(KEY_ESCAPE);
-
-        // Gamepad: levá páčka nebo D-pad pro navigaci
-        if (active_gamepad >= 0) {
-            float axis_y = GetGamepadAxisMovement(active_gamepad, GAMEPAD_AXIS_LEFT_Y);
-            bool dpad_up = IsGamepadButtonPressed(active_gamepad, GAMEPAD_BUTTON_LEFT_FACE_UP);
-            bool dpad_down = IsGamepadButtonPressed(active_gamepad, GAMEPAD_BUTTON_LEFT_FACE_DOWN);
-
-            if (gamepad_menu_delay == 0) {
-                if (axis_y < -0.5f || dpad_up) {
-                    up = true;
-                    gamepad_menu_delay = 15;
-                } else if (axis_y > 0.5f || dpad_down) {
-                    down = true;
-                    gamepad_menu_delay = 15;
-                }
-            } else {
-                gamepad_menu_delay--;
-            }
+        int up = input.GetRepeatSteps(InputAction::MENU_UP, MENU_REPEAT_MS, MENU_REPEAT_MS, 1);
+        int down = input.GetRepeatSteps(InputAction::MENU_DOWN, MENU_REPEAT_MS, MENU_REPEAT_MS, 1);
+        bool enter = input.IsPressed(InputAction::CONFIRM);
+        bool escape = input.IsPressed(InputAction::BACK);
 
-            enter = enter || IsGamepadButtonPressed(active_gamepad, GAMEPAD_BUTTON_RIGHT_FACE_DOWN); // A button
-            escape = escape || IsGamepadButtonPressed(active_gamepad, GAMEPAD_BUTTON_RIGHT_FACE_RIGHT); // B button
-        }
-
-        if (up) {
-            pause_menu_selected = (pause_menu_selected - 1 + 3) % 3;
-        }
-        if (down) {
-            pause_menu_selected = (pause_menu_selected + 1) % 3;
-        }
+        pause_menu_selected = ((pause_menu_selected - up + down) % 3 + 3) % 3;
         if (enter) {
             if (pause_menu_selected == 0) state = PLAYING;
             else if (pause_menu_selected == 1) state = MAIN_MENU;
@@ -261,122 +549,146 @@ void Game::HandleInput() {
             state = PLAYING;
         }
     } else if (state == PLAYING) {
-        bool escape = IsKeyPressed(KEY_ESCAPE);
-
-        // Gamepad: START button = pauza/ESC
-        if (active_gamepad >= 0) {
-            escape = escape || IsGamepadButtonPressed(active_gamepad, GAMEPAD_BUTTON_MIDDLE_RIGHT); // START button
-        }
-
-        if (escape) {
+        if (input.IsPressed(InputAction::PAUSE)) {
+            // Simulace musí stát, než hlavní vlákno sáhne na hru
+            if (simulation) simulation->Stop();
             if (game_over) {
                 state = MAIN_MENU;
             } else {
                 state = PAUSED;
+                SaveGame();
             }
             return;
         }
 
-        if (game_over || waiting_for_settlement || !current_tetromino || !current_tetromino->is_active) return;
+        // V souboji ovládá každý hráč svou desku vlastní polovinou klávesnice
+        int players = versus ? 2 : 1;
+        for (int i = 0; i < players; i++) {
+            TickInput tick_input = ReadTickInput(versus ? versus_inputs[i] : input);
+            tick_input.player = i;
+            if (simulation && simulation->IsRunning()) {
+                tick_inputs.Push(tick_input);
+            } else {
+                ApplyTickInput(tick_input);
+            }
+        }
+    }
+}
+
+TickInput Game::ReadTickInput(InputSystem& player_input) {
+    TickInput tick_input = {};
+    // Trénink: R nebo LB drží přetáčení zpět (funguje i po konci hry)
+    tick_input.rewind = mode == GameMode::PRACTICE && player_input.IsDown(InputAction::REWIND);
+    tick_input.rotations = player_input.IsPressed(InputAction::ROTATE) ? 1 : 0;
 
-        bool rotate = IsKeyPressed(KEY_UP);
+    // Posun s automatickým opakováním (DAS/ARR v ms) - v jednom ticku i víc kroků
+    int left_steps = player_input.GetRepeatSteps(InputAction::MOVE_LEFT, MOVE_DAS_MS, MOVE_ARR_MS, BOARD_WIDTH);
+    int right_steps = player_input.GetRepeatSteps(InputAction::MOVE_RIGHT, MOVE_DAS_MS, MOVE_ARR_MS, BOARD_WIDTH);
+    tick_input.move_steps = (left_steps > 0) ? -left_steps : right_steps;
 
-        // Gamepad: B button = rotace
-        if (active_gamepad >= 0) {
-            rotate = rotate || IsGamepadButtonPressed(active_gamepad, GAMEPAD_BUTTON_RIGHT_FACE_RIGHT) || IsGamepadButtonPressed(active_gamepad, GAMEPAD_BUTTON_LEFT_FACE_UP);
-        }
+    // Rychlý pád - nejvýš jeden posun za tick
+    tick_input.soft_drop = player_input.GetRepeatSteps(InputAction::SOFT_DROP, SOFT_DROP_REPEAT_MS, SOFT_DROP_REPEAT_MS, 1) > 0;
+    return tick_input;
+}
 
-        if (rotate) {
-            int old_rotation = current_tetromino->rotation;
-            current_tetromino->Rotate();
-            if (board->CheckCollision(current_tetromino->particles)) {
-                current_tetromino->rotation = old_rotation;
-                current_tetromino->GenerateParticles();
-            }
-        }
+void Game::ApplyTickInput(const TickInput& tick_input) {
+    // Souboj si ovládání sbírá po hráčích a provede ho v Versus::Tick
+    if (versus) {
+        versus->AddInput(tick_input);
+        return;
+    }
 
-        bool moved = false;
-        bool left_pressed = IsKeyDown(KEY_LEFT);
-        bool right_pressed = IsKeyDown(KEY_RIGHT);
+    if (mode == GameMode::PRACTICE) {
+        rewinding = tick_input.rewind;
+        if (rewinding) return;
+    }
 
-        // Gamepad: levá páčka nebo D-pad doleva/doprava
-        if (active_gamepad >= 0) {
-            float axis_x = GetGamepadAxisMovement(active_gamepad, GAMEPAD_AXIS_LEFT_X);
-            bool dpad_left = IsGamepadButtonDown(active_gamepad, GAMEPAD_BUTTON_LEFT_FACE_LEFT);
-            bool dpad_right = IsGamepadButtonDown(active_gamepad, GAMEPAD_BUTTON_LEFT_FACE_RIGHT);
+    if (game_over || waiting_for_settlement || !current_tetromino || !current_tetromino->is_active) return;
 
-            left_pressed = left_pressed || (axis_x < -0.5f) || dpad_left;
-            right_pressed = right_pressed || (axis_x > 0.5f) || dpad_right;
-        }
+    // V automatické hře ovládá kostku bot (viz UpdateBot)
+    if (mode == GameMode::AUTOPLAY) return;
 
-        if (left_pressed && !moved) {
-            if (move_counter_left == 0) {
-                current_tetromino->Move(-1, 0);
-                if (board->CheckCollision(current_tetromino->particles)) {
-                    current_tetromino->Move(1, 0);
-                }
-                move_counter_left = 1;
-                moved = true;
-            } else {
-                move_counter_left++;
-                if (move_counter_left >= MOVE_DELAY) {
-                    current_tetromino->Move(-1, 0);
-                    if (board->CheckCollision(current_tetromino->particles)) {
-                        current_tetromino->Move(1, 0);
-                    }
-                    move_counter_left = 1;
-                    moved = true;
-                }
-            }
-        } else if (!left_pressed) {
-            move_counter_left = 0;
+    for (int i = 0; i < tick_input.rotations; i++) {
+        int old_rotation = current_tetromino->rotation;
+        current_tetromino->Rotate();
+        if (board->CheckCollision(current_tetromino->particles)) {
+            current_tetromino->rotation = old_rotation;
+            current_tetromino->GenerateParticles();
+        } else {
+            PlaySfx(SfxId::ROTATE);
         }
+    }
 
-        if (right_pressed && !moved) {
-            if (move_counter_right == 0) {
-                current_tetromino->Move(1, 0);
-                if (board->CheckCollision(current_tetromino->particles)) {
-                    current_tetromino->Move(-1, 0);
-                }
-                move_counter_right = 1;
-                moved = true;
-            } else {
-                move_counter_right++;
-                if (move_counter_right >= MOVE_DELAY) {
-                    current_tetromino->Move(1, 0);
-                    if (board->CheckCollision(current_tetromino->particles)) {
-                        current_tetromino->Move(-1, 0);
-                    }
-                    move_counter_right = 1;
-                    moved = true;
-                }
-            }
-        } else if (!right_pressed) {
-            move_counter_right = 0;
+    int dx = (tick_input.move_steps < 0) ? -1 : 1;
+    for (int i = 0; i < std::abs(tick_input.move_steps); i++) {
+        current_tetromino->Move(dx, 0);
+        if (board->CheckCollision(current_tetromino->particles)) {
+            current_tetromino->Move(-dx, 0);
+            break;
         }
+    }
 
-        bool down_pressed = IsKeyDown(KEY_DOWN);
+    if (tick_input.soft_drop) {
+        fall_counter = FALL_SPEED;
+    }
+}
 
-        // Gamepad: A button = rychlý pád
-        if (active_gamepad >= 0) {
-            down_pressed = down_pressed || IsGamepadButtonDown(active_gamepad, GAMEPAD_BUTTON_RIGHT_FACE_DOWN) || IsGamepadButtonDown(active_gamepad, GAMEPAD_BUTTON_LEFT_FACE_DOWN);
+void Game::SimulationTick() {
+    // Sloučit ovládání ze všech ticků hlavního vlákna od minula
+    TickInput merged = {rewinding, 0, 0, false};
+    TickInput tick_input;
+    while (tick_inputs.Pop(tick_input)) {
+        if (versus) {
+            ApplyTickInput(tick_input);
+            continue;
         }
+        merged.rewind = tick_input.rewind;
+        merged.rotations += tick_input.rotations;
+        merged.move_steps += tick_input.move_steps;
+        merged.soft_drop = merged.soft_drop || tick_input.soft_drop;
+    }
+    if (!versus) ApplyTickInput(merged);
+    Update();
 
-        if (down_pressed) {
-            if (move_counter_down == 0) {
-                fall_counter = FALL_SPEED;
-                move_counter_down = 1;
-            } else {
-                move_counter_down++;
-                if (move_counter_down >= 3) {
-                    fall_counter = FALL_SPEED;
-                    move_counter_down = 1;
-                }
-            }
-        } else {
-            move_counter_down = 0;
-        }
+    CaptureGameFrame(frames.GetWriteBuffer());
+    frames.Publish();
+}
+
+void Game::CaptureGameFrame(GameFrame& frame) {
+    frame.versus = versus != nullptr;
+    if (versus) {
+        CaptureVersusPlayer(versus->players[0], frame);
+        CaptureVersusPlayer(versus->players[1], frame.rival);
+        frame.winner = versus->winner;
+        frame.game_over = versus->winner >= 0;
+        return;
     }
+
+    frame.has_board = board != nullptr;
+    if (board) board->CaptureFrame(frame.board);
+
+    frame.current_piece.clear();
+    if (current_tetromino && current_tetromino->is_active) {
+        frame.current_piece = current_tetromino->particles;
+    }
+
+    frame.has_next = next_tetromino != nullptr;
+    if (next_tetromino) {
+        frame.next_shape = next_tetromino->shape_type;
+        frame.next_color = next_tetromino->color;
+    }
+    frame.score = score;
+    frame.game_over = game_over;
+    frame.garbage = 0;
+}
+
+const GameFrame& Game::AcquireGameFrame() {
+    if (simulation && simulation->IsRunning()) {
+        frames.Update();
+        return frames.GetReadBuffer();
+    }
+    CaptureGameFrame(live_frame);
+    return live_frame;
 }
 
 // Aktualizace herní logiky
@@ -392,20 +704,65 @@ void Game::Update() {
         return;
     }
 
+    if (state == SPECTATING) {
+        UpdateSpectator();
+        return;
+    }
+
     // Update pouze když je hra aktivní
-    if (state != PLAYING || game_over) return;
+    if (state != PLAYING) return;
 
-    // Update fyziky a výbuchů (vždy běží)
-    board->ApplyGravity();
-    board->UpdatePreExplosionAnimation();
-    board->UpdateExplosions();
-    board->UpdateShake();
+    // Souboj - oba hráči v jednom ticku, zvuky se přehrají až po něm
+    if (versus) {
+        versus->Tick();
+        for (const VersusPlayer& player : versus->players) {
+            for (const VersusSound& sound : player.sounds) PlaySfx(sound.id, sound.intensity);
+        }
+        game_over = versus->winner >= 0;
+        return;
+    }
+
+    // Stav na konci minulého ticku pro diváky (včetně přetáčení a konce hry)
+    if (spectator_publisher) PublishSpectatorFrame();
+
+    // Přetáčení v tréninku nahrazuje simulaci
+    if (rewinding && rewind_buffer) {
+        UpdateRewind();
+        return;
+    }
+    if (game_over) return;
+
+    // Zaznamenat stav na konci minulého ticku
+    if (rewind_buffer) rewind_buffer->Capture(*board, GetRewindState());
+
+    // Update fyziky a výbuchů (vždy běží) - nezávislé fáze souběžně, viz BuildUpdateGraph
+    Board::ExplosionState explosion_before = board->explosion_state;
+    board->BeginTick();
+    update_graph->Run(*thread_pool);
+
+    // Zvuk dopadu - síla podle počtu částic, nejvýš jednou za pár ticků
+    if (landing_cooldown > 0) landing_cooldown--;
+    if (board->landed_count > 0 && landing_cooldown == 0) {
+        PlaySfx(SfxId::LANDING, std::min(1.0f, board->landed_count / 50.0f));
+        landing_cooldown = 6;
+    }
+    if (explosion_before == Board::ExplosionState::ZOOMING && board->explosion_state == Board::ExplosionState::EXPLODING) {
+        PlaySfx(SfxId::EXPLOSION, std::min(1.0f, explosion_group_size / 1500.0f));
+    }
 
-    // Kontrola propojených částic a výpočet skóre
-    int removed = board->CheckHorizontalConnections();
+    // Výsledek kontroly propojených částic a výpočet skóre
+    int removed = connections_removed;
     if (removed > 0) {
-        score += removed;
-        board->grid_dirty = true;
+        // Kombo - víc skupin vybuchlých najednou násobí body jejich počtem
+        int combo = std::max(1, (int)board->exploding_groups.size());
+        score += removed * combo;
+        explosion_group_size = removed;
+        PlaySfx(SfxId::CHARGE);
+        if (spectator_publisher) {
+            for (const ExplosionGroup& group : board->exploding_groups) {
+                spectator_publisher->AddExplosion(std::max(0, GetColorIndex(group.color)), group.grains);
+            }
+        }
 
         // Zvýšení rychlosti každých 1000 bodů
         // Čím více bodů, tím rychleji padají bloky (minimálně 10 framů)
@@ -427,6 +784,8 @@ void Game::Update() {
 
     // Update padajícího tetromina
     if (current_tetromino && current_tetromino->is_active) {
+        if (mode == GameMode::AUTOPLAY) UpdateBot();
+
         fall_counter++;
 
         // Automatický pád tetromina podle current_fall_speed
@@ -443,7 +802,7 @@ void Game::Update() {
 
                 // Přidat částice na desku
                 board->AddParticles(current_tetromino->particles);
-                board->grid_dirty = true;
+                PlaySfx(SfxId::LOCK);
 
                 // Okamžitě deaktivovat tetromino (zmizí z obrazovky)
                 current_tetromino->is_active = false;
@@ -455,12 +814,121 @@ void Game::Update() {
     }
 }
 
+void Game::BuildUpdateGraph() {
+    update_graph = new TaskGraph();
+
+    // Jiskry výbuchu nezávisí na gravitaci - počítají se souběžně s ní.
+    // Nové jiskry přidá až animace výbuchu, poprvé se tedy posunou v dalším ticku.
+    int sparks = update_graph->AddTask([this] { board->UpdateExplosions(); });
+    int gravity = update_graph->AddTask([this] { board->ApplyGravity(); });
+
+    // Animace výbuchu maže částice a přidává jiskry - čeká na obojí
+    int explosion = update_graph->AddTask([this] { board->UpdatePreExplosionAnimation(); }, {sparks, gravity});
+
+    // Po výbuchu jen čtou desku (nebo mění disjunktní stav) - běží souběžně
+    update_graph->AddTask([this] { board->UpdateShake(); }, {explosion});
+    update_graph->AddTask([this] { if (frame_recorder) frame_recorder->RecordTick(*board); }, {explosion});
+    update_graph->AddTask([this] { connections_removed = board->CheckHorizontalConnections(); }, {explosion});
+}
+
+void Game::UpdateBot() {
+    // Najít cílové umístění pro novou kostku
+    if (!bot_has_target) {
+        bot_target = bot->FindBestPlacement(*board, *current_tetromino, next_tetromino);
+        bot_has_target = true;
+    }
+    if (!bot_target.valid) return;
+
+    // Jeden krok za frame: nejdřív rotace, pak posun, nakonec rychlý pád
+    if (current_tetromino->rotation != bot_target.rotation) {
+        int old_rotation = current_tetromino->rotation;
+        current_tetromino->Rotate();
+        if (board->CheckCollision(current_tetromino->particles)) {
+            current_tetromino->rotation = old_rotation;
+            current_tetromino->GenerateParticles();
+            bot_target.valid = false; // Cíl není dosažitelný, kostka jen dopadne
+        } else {
+            PlaySfx(SfxId::ROTATE);
+        }
+        return;
+    }
+
+    if (current_tetromino->board_x != bot_target.board_x) {
+        int dx = (bot_target.board_x > current_tetromino->board_x) ? 1 : -1;
+        current_tetromino->Move(dx, 0);
+        if (board->CheckCollision(current_tetromino->particles)) {
+            current_tetromino->Move(-dx, 0);
+            bot_target.valid = false;
+        }
+        return;
+    }
+
+    fall_counter = current_fall_speed;
+}
+
+void Game::PrepareGradientBackground(Color top, Color bottom) {
+    if (!IsRenderTextureValid(background_texture)) {
+        background_texture = LoadRenderTexture(SCREEN_WIDTH, SCREEN_HEIGHT);
+    }
+    BeginTextureMode(background_texture);
+    DrawGradientLines(top, bottom);
+    EndTextureMode();
+    background_top = top;
+    background_bottom = bottom;
+}
+
+void Game::PrepareCanvas() {
+    canvas = LoadRenderTexture((int)(SCREEN_WIDTH * RENDER_SCALE), (int)(SCREEN_HEIGHT * RENDER_SCALE));
+    if (!IsRenderTextureValid(canvas)) {
+        // Bez render textur zůstává kreslení přímo do okna v původní velikosti
+        TraceLog(LOG_WARNING, "RENDER: Canvas not available, drawing directly to the window");
+        ClearWindowState(FLAG_WINDOW_RESIZABLE);
+        canvas_scale = 1.0f;
+        return;
+    }
+    SetTextureFilter(canvas.texture, TEXTURE_FILTER_POINT);
+    canvas_scale = RENDER_SCALE;
+    SetWindowMinSize(canvas.texture.width, canvas.texture.height);
+}
+
+void Game::BeginCanvasCamera(Camera2D camera) {
+    camera.offset.x *= canvas_scale;
+    camera.offset.y *= canvas_scale;
+    camera.zoom *= canvas_scale;
+    BeginMode2D(camera);
+}
+
+void Game::EndCanvasCamera() {
+    BeginCanvasCamera(Camera2D{{0, 0}, {0, 0}, 0.0f, 1.0f});
+}
+
+void Game::PresentCanvas() {
+    // Okno v pixelech framebufferu (HiDPI) - celočíselný násobek plátna se počítá v nich
+    float render_width = (float)GetRenderWidth();
+    float render_height = (float)GetRenderHeight();
+    float dpi_x = render_width / std::max(1, GetScreenWidth());
+    float dpi_y = render_height / std::max(1, GetScreenHeight());
+    float fit = std::min(render_width / canvas.texture.width, render_height / canvas.texture.height);
+    float factor = (fit >= 1.0f) ? std::floor(fit) : fit;
+
+    float width = canvas.texture.width * factor;
+    float height = canvas.texture.height * factor;
+    canvas_dest = {std::floor((render_width - width) / 2.0f) / dpi_x, std::floor((render_height - height) / 2.0f) / dpi_y,
+                   width / dpi_x, height / dpi_y};
+
+    // Render textura je v OpenGL vzhůru nohama
+    DrawTexturePro(canvas.texture, Rectangle{0, 0, (float)canvas.texture.width, -(float)canvas.texture.height},
+                   canvas_dest, Vector2{0, 0}, 0.0f, WHITE);
+}
+
 void Game::DrawGradientBackground(Color top, Color bottom) {
-    for (int y = 0; y < SCREEN_HEIGHT; y++) {
-        float blend = (float)y / SCREEN_HEIGHT;
-        Color c = BlendColors(top, bottom, blend);
-        DrawLine(0, y, SCREEN_WIDTH, y, c);
+    // Předkreslený gradient - jedna textura místo čáry pro každý řádek obrazovky
+    if (IsRenderTextureValid(background_texture) && ColorIsEqual(top, background_top) && ColorIsEqual(bottom, background_bottom)) {
+        // Render textura je v OpenGL vzhůru nohama
+        DrawTextureRec(background_texture.texture, Rectangle{0, 0, (float)SCREEN_WIDTH, -(float)SCREEN_HEIGHT}, Vector2{0, 0}, WHITE);
+        return;
     }
+    DrawGradientLines(top, bottom);
 }
 
 void Game::DrawMainMenu() {
@@ -478,131 +946,255 @@ void Game::DrawMainMenu() {
         DrawCircle((int)x, (int)y, size, particle_color);
     }
 
-    const char* items[] = {
-        localization.GetText(TextKey::MAIN_MENU_NEW_GAME),
-        localization.GetText(TextKey::MAIN_MENU_SETTINGS),
-        localization.GetText(TextKey::MAIN_MENU_EXIT)
-    };
-    int y_start = 350;
-    int y_spacing = 80;
-
-    for (int i = 0; i < 3; i++) {
-        Color color = (i == main_menu_selected) ? Color{255, 100, 0, 255} : WHITE;
-        int text_width = MeasureText(items[i], 48);
-        DrawText(items[i], SCREEN_WIDTH / 2 - text_width / 2, y_start + i * y_spacing, 48, color);
-
-        if (i == main_menu_selected) {
-            DrawText(">", SCREEN_WIDTH / 2 - text_width / 2 - 40, y_start + i * y_spacing, 48, color);
-        }
-    }
+    UpdateMenuLabels();
+    DrawMenuLabels(main_menu_labels, main_menu_label_count, main_menu_selected, 350, 80);
 }
 
 void Game::DrawSettingsMenu() {
     DrawGradientBackground(BG_COLOR_TOP, BG_COLOR_BOTTOM);
+    UpdateMenuLabels();
+
+    DrawText(settings_title_label.text, SCREEN_WIDTH / 2 - settings_title_label.width / 2, 150, 72, WHITE);
+    DrawText(settings_info_label.text, SCREEN_WIDTH / 2 - settings_info_label.width / 2, 250, 28, Color{200, 200, 220, 255});
+
+    DrawMenuLabels(settings_menu_labels, 8, settings_menu_selected, 290, 56);
 
-    const char* title = localization.GetText(TextKey::SETTINGS_TITLE);
-    DrawText(title, SCREEN_WIDTH / 2 - MeasureText(title, 72) / 2, 150, 72, WHITE);
+    DrawText(settings_back_label.text, SCREEN_WIDTH / 2 - settings_back_label.width / 2, 750, 28, Color{150, 150, 170, 255});
+}
 
-    const char* info = localization.GetText(TextKey::SETTINGS_DIFFICULTY_INFO);
-    DrawText(info, SCREEN_WIDTH / 2 - MeasureText(info, 28) / 2, 250, 28, Color{200, 200, 220, 255});
+void Game::DrawPauseMenu() {
+    DrawRectangle(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, ColorWithAlpha(BLACK, 200));
+    UpdateMenuLabels();
 
-    // Gamepad text
-    char gamepad_text[128];
-    if (active_gamepad >= 0 && IsGamepadAvailable(active_gamepad)) {
+    DrawText(pause_title_label.text, SCREEN_WIDTH / 2 - pause_title_label.width / 2, 150, 72, WHITE);
+    DrawMenuLabels(pause_menu_labels, 3, pause_menu_selected, 350, 80);
+}
+
+void Game::FormatMenuLabel(MenuLabel& label, int font_size, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    vsnprintf(label.text, sizeof(label.text), format, args);
+    va_end(args);
+    label.width = MeasureText(label.text, font_size);
+}
+
+MenuLabelKey Game::GetMenuLabelKey() const {
+    bool gamepad_available = active_gamepad >= 0 && IsGamepadAvailable(active_gamepad);
+    return {localization.GetRevision(), gamepad_available ? active_gamepad : -1,
+            MUSIC_ENABLED, SFX_ENABLED, FPS_ENABLED, has_saved_game};
+}
+
+void Game::UpdateMenuLabels() {
+    MenuLabelKey key = GetMenuLabelKey();
+    bool gamepad_available = key.gamepad >= 0;
+    if (menu_labels_valid && key == menu_labels_key) return;
+    menu_labels_key = key;
+    menu_labels_valid = true;
+
+    // Hlavní menu
+    MainMenuItem menu_items[7];
+    main_menu_label_count = GetMainMenuItems(menu_items);
+    for (int i = 0; i < main_menu_label_count; i++) {
+        TextKey text_key = TextKey::MAIN_MENU_EXIT;
+        switch (menu_items[i]) {
+            case MainMenuItem::CONTINUE: text_key = TextKey::MAIN_MENU_CONTINUE; break;
+            case MainMenuItem::NEW_GAME: text_key = TextKey::MAIN_MENU_NEW_GAME; break;
+            case MainMenuItem::PRACTICE: text_key = TextKey::MAIN_MENU_PRACTICE; break;
+            case MainMenuItem::AUTOPLAY: text_key = TextKey::MAIN_MENU_AUTOPLAY; break;
+            case MainMenuItem::VERSUS: text_key = TextKey::MAIN_MENU_VERSUS; break;
+            case MainMenuItem::SETTINGS: text_key = TextKey::MAIN_MENU_SETTINGS; break;
+            case MainMenuItem::EXIT: text_key = TextKey::MAIN_MENU_EXIT; break;
+        }
+        FormatMenuLabel(main_menu_labels[i], 48, "%s", localization.GetText(text_key));
+    }
+
+    // Nastavení
+    const char* on = localization.GetText(TextKey::SETTINGS_ON);
+    const char* off = localization.GetText(TextKey::SETTINGS_OFF);
+    FormatMenuLabel(settings_title_label, 72, "%s", localization.GetText(TextKey::SETTINGS_TITLE));
+    FormatMenuLabel(settings_info_label, 28, "%s", localization.GetText(TextKey::SETTINGS_DIFFICULTY_INFO));
+    FormatMenuLabel(settings_back_label, 28, "%s", localization.GetText(TextKey::SETTINGS_BACK));
+    FormatMenuLabel(settings_menu_labels[0], 48, "%s", localization.GetText(TextKey::SETTINGS_EASY));
+    FormatMenuLabel(settings_menu_labels[1], 48, "%s", localization.GetText(TextKey::SETTINGS_NORMAL));
+    FormatMenuLabel(settings_menu_labels[2], 48, "%s", localization.GetText(TextKey::SETTINGS_HARD));
+    FormatMenuLabel(settings_menu_labels[3], 48, "%s: %s", localization.GetText(TextKey::SETTINGS_MUSIC), MUSIC_ENABLED ? on : off);
+    FormatMenuLabel(settings_menu_labels[4], 48, "%s: %s", localization.GetText(TextKey::SETTINGS_SFX), SFX_ENABLED ? on : off);
+    FormatMenuLabel(settings_menu_labels[5], 48, "%s: %s", localization.GetText(TextKey::SETTINGS_FPS), FPS_ENABLED ? on : off);
+    if (gamepad_available) {
         const char* gamepad_name = GetGamepadName(active_gamepad);
-        snprintf(gamepad_text, sizeof(gamepad_text), "%s: %s",
-                 localization.GetText(TextKey::SETTINGS_GAMEPAD),
-                 gamepad_name ? gamepad_name : localization.GetText(TextKey::SETTINGS_GAMEPAD_CONNECTED));
+        FormatMenuLabel(settings_menu_labels[6], 48, "%s: %s",
+                        localization.GetText(TextKey::SETTINGS_GAMEPAD),
+                        gamepad_name ? gamepad_name : localization.GetText(TextKey::SETTINGS_GAMEPAD_CONNECTED));
     } else {
-        snprintf(gamepad_text, sizeof(gamepad_text), "%s: %s",
-                 localization.GetText(TextKey::SETTINGS_GAMEPAD),
-                 localization.GetText(TextKey::SETTINGS_GAMEPAD_NOT_CONNECTED));
-    }
-
-    // Music text
-    char music_text[64];
-    snprintf(music_text, sizeof(music_text), "%s: %s",
-             localization.GetText(TextKey::SETTINGS_MUSIC),
-             MUSIC_ENABLED ? localization.GetText(TextKey::SETTINGS_ON) : localization.GetText(TextKey::SETTINGS_OFF));
-
-    // FPS text
-    char fps_text[64];
-    snprintf(fps_text, sizeof(fps_text), "%s: %s",
-             localization.GetText(TextKey::SETTINGS_FPS),
-             FPS_ENABLED ? localization.GetText(TextKey::SETTINGS_ON) : localization.GetText(TextKey::SETTINGS_OFF));
-
-    // Language text
-    char language_text[64];
-    snprintf(language_text, sizeof(language_text), "%s: %s",
-             localization.GetText(TextKey::SETTINGS_LANGUAGE),
-             localization.GetCurrentLanguageName());
-
-    const char* items[] = {
-        localization.GetText(TextKey::SETTINGS_EASY),
-        localization.GetText(TextKey::SETTINGS_NORMAL),
-        localization.GetText(TextKey::SETTINGS_HARD),
-        music_text,
-        fps_text,
-        gamepad_text,
-        language_text
-    };
-    int y_start = 290;
-    int y_spacing = 60;
+        FormatMenuLabel(settings_menu_labels[6], 48, "%s: %s",
+                        localization.GetText(TextKey::SETTINGS_GAMEPAD),
+                        localization.GetText(TextKey::SETTINGS_GAMEPAD_NOT_CONNECTED));
+    }
+    FormatMenuLabel(settings_menu_labels[7], 48, "%s: %s",
+                    localization.GetText(TextKey::SETTINGS_LANGUAGE), localization.GetCurrentLanguageName());
+
+    // Pauza
+    FormatMenuLabel(pause_title_label, 72, "%s", localization.GetText(TextKey::PAUSE_TITLE));
+    FormatMenuLabel(pause_menu_labels[0], 48, "%s", localization.GetText(TextKey::PAUSE_RESUME));
+    FormatMenuLabel(pause_menu_labels[1], 48, "%s", localization.GetText(TextKey::PAUSE_MAIN_MENU));
+    FormatMenuLabel(pause_menu_labels[2], 48, "%s", localization.GetText(TextKey::PAUSE_EXIT));
+}
 
-    for (int i = 0; i < 7; i++) {
-        Color color = (i == settings_menu_selected) ? Color{255, 100, 0, 255} : WHITE;
-        int text_width = MeasureText(items[i], 48);
-        DrawText(items[i], SCREEN_WIDTH / 2 - text_width / 2, y_start + i * y_spacing, 48, color);
+void Game::DrawMenuLabels(const MenuLabel* labels, int count, int selected, int y_start, int y_spacing) {
+    for (int i = 0; i < count; i++) {
+        Color color = (i == selected) ? Color{255, 100, 0, 255} : WHITE;
+        DrawText(labels[i].text, SCREEN_WIDTH / 2 - labels[i].width / 2, y_start + i * y_spacing, 48, color);
 
-        if (i == settings_menu_selected) {
-            DrawText(">", SCREEN_WIDTH / 2 - text_width / 2 - 40, y_start + i * y_spacing, 48, color);
+        if (i == selected) {
+            DrawText(">", SCREEN_WIDTH / 2 - labels[i].width / 2 - 40, y_start + i * y_spacing, 48, color);
         }
     }
-
-    const char* esc = localization.GetText(TextKey::SETTINGS_BACK);
-    DrawText(esc, SCREEN_WIDTH / 2 - MeasureText(esc, 28) / 2, 750, 28, Color{150, 150, 170, 255});
 }
 
-void Game::DrawPauseMenu() {
-    DrawRectangle(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, ColorWithAlpha(BLACK, 200));
+void Game::LayoutBoard() {
+    // Plocha vlevo od panelu se skóre (PANEL_X v DrawGame)
+    constexpr float AREA_X = 50.0f, AREA_Y = 50.0f;
+    constexpr float AREA_WIDTH = 520.0f - 20.0f - AREA_X;
+    constexpr float AREA_HEIGHT = SCREEN_HEIGHT - 2 * AREA_Y;
+
+    float board_width_px = (float)BOARD_WIDTH * CELL_SIZE;
+    float board_height_px = (float)BOARD_HEIGHT * CELL_SIZE;
+    float zoom = std::min({1.0f, AREA_WIDTH / board_width_px, AREA_HEIGHT / board_height_px});
+
+    // Zmenšená deska se vystředí vodorovně, klasická zůstane na místě
+    float board_x = AREA_X;
+    if (zoom < 1.0f) board_x += (AREA_WIDTH - board_width_px * zoom) / 2.0f;
+    board_viewport = {board_x, AREA_Y, board_width_px * zoom, board_height_px * zoom};
+
+    // Kamera míří na střed pohledu, při camera_zoom 1 je to střed desky
+    board_camera.offset = {board_x + board_viewport.width / 2.0f, AREA_Y + board_viewport.height / 2.0f};
+    board_camera.target = {board_width_px / 2.0f, board_height_px / 2.0f};
+    board_camera.rotation = 0.0f;
+    board_camera.zoom = zoom;
+
+    camera_zoom = 1.0f;
+    camera_center = board_camera.target;
+    camera_follow = true;
+}
 
-    const char* title = localization.GetText(TextKey::PAUSE_TITLE);
-    DrawText(title, SCREEN_WIDTH / 2 - MeasureText(title, 72) / 2, 150, 72, WHITE);
+void Game::UpdateBoardCamera() {
+    if ((state != PLAYING && state != SPECTATING) || versus) return;
+
+    // Nejvíc do měřítka 1:1, klasická deska se tedy nepřibližuje
+    float max_zoom = std::max(1.0f, 1.0f / board_camera.zoom);
+    float zoom = camera_zoom;
+    float wheel = GetMouseWheelMove();
+    if (wheel != 0.0f) zoom *= 1.0f + 0.1f * wheel;
+    if (IsKeyPressed(KEY_EQUAL) || IsKeyPressed(KEY_KP_ADD)) zoom *= 1.25f;
+    if (IsKeyPressed(KEY_MINUS) || IsKeyPressed(KEY_KP_SUBTRACT)) zoom /= 1.25f;
+    zoom = std::clamp(zoom, 1.0f, max_zoom);
+    if (zoom != camera_zoom) {
+        camera_zoom = zoom;
+        camera_changed = true;
+    }
 
-    const char* items[] = {
-        localization.GetText(TextKey::PAUSE_RESUME),
-        localization.GetText(TextKey::PAUSE_MAIN_MENU),
-        localization.GetText(TextKey::PAUSE_EXIT)
-    };
-    int y_start = 350;
-    int y_spacing = 80;
+    if (IsMouseButtonDown(MOUSE_BUTTON_RIGHT)) {
+        // Posun myši v okně přepočítat na souřadnice hry (plátno bývá zvětšené)
+        Vector2 delta = GetMouseDelta();
+        if (delta.x != 0.0f || delta.y != 0.0f) {
+            float scale = board_camera.zoom * camera_zoom * canvas_dest.width / SCREEN_WIDTH;
+            camera_center.x -= delta.x / scale;
+            camera_center.y -= delta.y / scale;
+            camera_follow = false;
+            camera_changed = true;
+        }
+    }
+    if (IsKeyPressed(KEY_HOME)) {
+        camera_follow = true;
+        camera_changed = true;
+    }
+}
 
-    for (int i = 0; i < 3; i++) {
-        Color color = (i == pause_menu_selected) ? Color{255, 100, 0, 255} : WHITE;
-        int text_width = MeasureText(items[i], 48);
-        DrawText(items[i], SCREEN_WIDTH / 2 - text_width / 2, y_start + i * y_spacing, 48, color);
+Camera2D Game::FrameBoardCamera(const GameFrame& frame) {
+    float board_width_px = (float)BOARD_WIDTH * CELL_SIZE;
+    float board_height_px = (float)BOARD_HEIGHT * CELL_SIZE;
 
-        if (i == pause_menu_selected) {
-            DrawText(">", SCREEN_WIDTH / 2 - text_width / 2 - 40, y_start + i * y_spacing, 48, color);
+    if (camera_follow && !frame.current_piece.empty()) {
+        Vector2 piece = {0, 0};
+        for (auto& p : frame.current_piece) {
+            piece.x += p.x;
+            piece.y += p.y;
         }
+        float count = (float)frame.current_piece.size();
+        piece = {piece.x / count * PARTICLE_SIZE, piece.y / count * PARTICLE_SIZE};
+        camera_center.x += (piece.x - camera_center.x) * 0.15f;
+        camera_center.y += (piece.y - camera_center.y) * 0.15f;
     }
+
+    // Pohled nesmí vyjet mimo desku (je-li větší než deska, zůstane na středu)
+    Camera2D camera = board_camera;
+    camera.zoom = board_camera.zoom * camera_zoom;
+    float half_width = board_viewport.width / 2.0f / camera.zoom;
+    float half_height = board_viewport.height / 2.0f / camera.zoom;
+    camera_center.x = (half_width * 2 >= board_width_px) ? board_width_px / 2.0f
+                      : std::clamp(camera_center.x, half_width, board_width_px - half_width);
+    camera_center.y = (half_height * 2 >= board_height_px) ? board_height_px / 2.0f
+                      : std::clamp(camera_center.y, half_height, board_height_px - half_height);
+    camera.target = camera_center;
+    return camera;
 }
 
 void Game::DrawGame() {
     DrawGradientBackground(BG_COLOR_TOP, BG_COLOR_BOTTOM);
 
-    Vector2 shake = board ? board->GetShakeOffset() : Vector2{0, 0};
-    int shake_offset_x = offset_x + (int)shake.x;
-    int shake_offset_y = offset_y + (int)shake.y;
+    // Kreslí se jen ze snímku - simulace mezitím může běžet na svém vlákně
+    const GameFrame& frame = AcquireGameFrame();
+    drawn_particle_count = frame.has_board ? frame.board.particle_count : 0;
+    camera_changed = false;
+    if (frame.versus) {
+        DrawVersus(frame);
+        return;
+    }
 
-    if (board) {
-        board->Draw(shake_offset_x, shake_offset_y);
+    // Záznam hry - jen kopie snímku, kóduje se na vlastních vláknech (zmrazený snímek pauzy se neukládá)
+    if (!CAPTURE_PATH.empty() && frame.has_board && state != PAUSED) {
+        if (!clip_recorder) clip_recorder = new ClipRecorder(CAPTURE_PATH, frame.board.width, frame.board.height);
+        clip_recorder->CaptureFrame(frame.board, frame.current_piece);
     }
 
-    if (current_tetromino && current_tetromino->is_active) {
-        current_tetromino->Draw(shake_offset_x, shake_offset_y);
+    // Deska a kostka se kreslí v souřadnicích desky, třesení posouvá celý pohled
+    Vector2 shake = frame.has_board ? frame.board.shake : Vector2{0, 0};
+    Camera2D camera = FrameBoardCamera(frame);
+    camera.offset.x += (int)shake.x;
+    camera.offset.y += (int)shake.y;
+
+    // Přiblížená deska přesahuje plochu - ořezat (s místem pro rámeček)
+    bool clipped = camera_zoom > 1.0f;
+    if (clipped) {
+        BeginScissorMode((int)((board_viewport.x - 3) * canvas_scale), (int)((board_viewport.y - 3) * canvas_scale),
+                         (int)((board_viewport.width + 6) * canvas_scale), (int)((board_viewport.height + 6) * canvas_scale));
+    }
+    BeginCanvasCamera(camera);
+
+    if (frame.has_board && board) {
+        // Viditelná oblast v buňkách částic (s okrajem na zaokrouhlení)
+        Vector2 top_left = GetScreenToWorld2D({board_viewport.x, board_viewport.y}, camera);
+        Vector2 bottom_right = GetScreenToWorld2D({board_viewport.x + board_viewport.width,
+                                                   board_viewport.y + board_viewport.height}, camera);
+        Rectangle view = {top_left.x / PARTICLE_SIZE - 1, top_left.y / PARTICLE_SIZE - 1,
+                          (bottom_right.x - top_left.x) / PARTICLE_SIZE + 2,
+                          (bottom_right.y - top_left.y) / PARTICLE_SIZE + 2};
+
+        // Částice menší než pixel - celá deska jako jedna textura
+        if (camera.zoom * PARTICLE_SIZE < 1.0f) {
+            board->DrawOverview(frame.board, 0, 0);
+        } else {
+            board->Draw(frame.board, view, 0, 0);
+        }
+    }
+
+    for (auto& p : frame.current_piece) {
+        p.Draw(0, 0, true); // true = enhanced rendering
     }
 
+    EndCanvasCamera();
+    if (clipped) EndScissorMode();
+
     int panel_x = 520;
     int panel_y = 50;
     int panel_width = 250;
@@ -612,11 +1204,11 @@ void Game::DrawGame() {
     DrawRectangleLines(panel_x, panel_y, panel_width, panel_height, Color{100, 100, 150, 255});
 
     DrawText(localization.GetText(TextKey::GAME_SCORE), panel_x + 20, panel_y + 20, 28, Color{150, 150, 200, 255});
-    DrawText(TextFormat("%d", score), panel_x + 20, panel_y + 50, 48, WHITE);
+    DrawText(TextFormat("%d", frame.score), panel_x + 20, panel_y + 50, 48, WHITE);
 
     DrawText(localization.GetText(TextKey::GAME_NEXT_PIECE), panel_x + 20, panel_y + 120, 28, Color{150, 150, 200, 255});
 
-    if (next_tetromino) {
+    if (frame.has_next) {
         int preview_box_x = panel_x + 50;
         int preview_box_y = panel_y + 155;
         int preview_box_size = 160;
@@ -626,7 +1218,7 @@ void Game::DrawGame() {
         DrawRectangleLines(preview_box_x, preview_box_y, preview_box_size, preview_box_size,
                          Color{80, 80, 120, 255});
 
-        auto shape = GetShape(next_tetromino->shape_type, 0);
+        auto shape = GetShape(frame.next_shape, 0);
         if (!shape.empty()) {
             int min_x = 100, max_x = 0, min_y = 100, max_y = 0;
             for (auto& block : shape) {
@@ -647,9 +1239,10 @@ void Game::DrawGame() {
                         int x_pos = center_offset_x + (int)block.x * CELL_SIZE + px * PARTICLE_SIZE;
                         int y_pos = center_offset_y + (int)block.y * CELL_SIZE + py * PARTICLE_SIZE;
 
-                        DrawRectangle(x_pos, y_pos, PARTICLE_SIZE, PARTICLE_SIZE, next_tetromino->color);
+                        if (grain_atlas.DrawGrain(frame.next_color, GrainAtlas::PREVIEW, (float)x_pos, (float)y_pos, PARTICLE_SIZE)) continue;
 
-                        Color highlight = BrightenColor(next_tetromino->color, 1.3f);
+                        DrawRectangle(x_pos, y_pos, PARTICLE_SIZE, PARTICLE_SIZE, frame.next_color);
+                        Color highlight = BrightenColor(frame.next_color, 1.3f);
                         DrawLine(x_pos, y_pos, x_pos + PARTICLE_SIZE - 1, y_pos, highlight);
                         DrawLine(x_pos, y_pos, x_pos, y_pos + PARTICLE_SIZE - 1, highlight);
                     }
@@ -661,7 +1254,9 @@ void Game::DrawGame() {
     DrawText(localization.GetText(TextKey::GAME_DIFFICULTY), panel_x + 20, panel_y + 335, 28, Color{150, 150, 200, 255});
 
     Color diff_colors[] = {{100, 255, 100, 255}, {255, 200, 100, 255}, {255, 100, 100, 255}};
-    int diff_idx = (NUM_COLORS == 3) ? 0 : (NUM_COLORS == 4) ? 1 : 2;
+    // Divák ukazuje obtížnost vysílající hry, vlastní nastavení nemění
+    int num_colors = (state == SPECTATING) ? spectator_client->state.num_colors : NUM_COLORS;
+    int diff_idx = (num_colors == 3) ? 0 : (num_colors == 4) ? 1 : 2;
     const char* diff_names[] = {
         localization.GetText(TextKey::DIFFICULTY_EASY),
         localization.GetText(TextKey::DIFFICULTY_NORMAL),
@@ -669,14 +1264,18 @@ void Game::DrawGame() {
     };
     DrawText(diff_names[diff_idx], panel_x + 20, panel_y + 365, 36, diff_colors[diff_idx]);
 
-    if (game_over) {
+    if (mode == GameMode::PRACTICE) {
+        DrawText(localization.GetText(TextKey::GAME_REWIND_HINT), panel_x + 20, panel_y + 430, 20, Color{150, 150, 200, 255});
+    }
+
+    if (frame.game_over) {
         DrawRectangle(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, ColorWithAlpha(BLACK, 180));
 
         const char* go_text = localization.GetText(TextKey::GAME_OVER_TITLE);
         int go_width = MeasureText(go_text, 96);
         DrawText(go_text, SCREEN_WIDTH / 2 - go_width / 2, SCREEN_HEIGHT / 2 - 50, 96, Color{255, 80, 80, 255});
 
-        const char* score_text = TextFormat("%s: %d", localization.GetText(TextKey::GAME_OVER_SCORE), score);
+        const char* score_text = TextFormat("%s: %d", localization.GetText(TextKey::GAME_OVER_SCORE), frame.score);
         int score_width = MeasureText(score_text, 48);
         DrawText(score_text, SCREEN_WIDTH / 2 - score_width / 2, SCREEN_HEIGHT / 2 + 30, 48, WHITE);
 
@@ -686,9 +1285,135 @@ void Game::DrawGame() {
     }
 }
 
+void Game::DrawVersus(const GameFrame& frame) {
+    const PlayerFrame* players[2] = {&frame, &frame.rival};
+    drawn_particle_count = frame.board.particle_count + frame.rival.board.particle_count;
+
+    // Každý hráč má polovinu obrazovky, deska se do ní vejde celá
+    constexpr float AREA_Y = 120.0f;
+    constexpr float AREA_WIDTH = SCREEN_WIDTH / 2.0f - 60.0f;
+    constexpr float AREA_HEIGHT = SCREEN_HEIGHT - AREA_Y - 20.0f;
+    float board_width_px = (float)BOARD_WIDTH * CELL_SIZE;
+    float board_height_px = (float)BOARD_HEIGHT * CELL_SIZE;
+    float zoom = std::min({1.0f, AREA_WIDTH / board_width_px, AREA_HEIGHT / board_height_px});
+    Rectangle view = {0, 0, (float)BOARD_WIDTH * PARTICLES_PER_BLOCK, (float)BOARD_HEIGHT * PARTICLES_PER_BLOCK};
+
+    for (int i = 0; i < 2; i++) {
+        const PlayerFrame& player = *players[i];
+        float area_x = i * SCREEN_WIDTH / 2.0f + 40.0f;
+        float board_x = area_x + (AREA_WIDTH - board_width_px * zoom) / 2.0f;
+        float board_y = AREA_Y;
+
+        DrawText(TextFormat("%s %d", localization.GetText(TextKey::GAME_VERSUS_PLAYER), i + 1),
+                 (int)area_x, 40, 28, Color{150, 150, 200, 255});
+        DrawText(TextFormat("%d", player.score), (int)area_x, 72, 36, WHITE);
+
+        // Náhled další kostky vpravo nad deskou
+        constexpr int PREVIEW_BLOCK = 12;
+        for (auto& block : GetShape(player.next_shape, 0)) {
+            int x_pos = (int)(area_x + AREA_WIDTH) - 4 * PREVIEW_BLOCK + (int)block.x * PREVIEW_BLOCK;
+            int y_pos = 50 + (int)block.y * PREVIEW_BLOCK;
+            DrawRectangle(x_pos, y_pos, PREVIEW_BLOCK - 1, PREVIEW_BLOCK - 1, player.next_color);
+        }
+
+        Camera2D camera = {};
+        camera.offset = {board_x + (int)player.board.shake.x, board_y + (int)player.board.shake.y};
+        camera.zoom = zoom;
+        BeginCanvasCamera(camera);
+        if (versus) {
+            Board* player_board = versus->players[i].board;
+            if (zoom * PARTICLE_SIZE < 1.0f) {
+                player_board->DrawOverview(player.board, 0, 0);
+            } else {
+                player_board->Draw(player.board, view, 0, 0);
+            }
+        }
+        for (auto& p : player.current_piece) {
+            p.Draw(0, 0, true);
+        }
+        EndCanvasCamera();
+
+        // Písek čekající na shození - sloupec vlevo od desky (výška = řádky částic)
+        if (player.garbage > 0) {
+            float rows = (float)player.garbage / (BOARD_WIDTH * PARTICLES_PER_BLOCK);
+            float bar_height = std::min(board_height_px * zoom, rows * PARTICLE_SIZE * zoom);
+            DrawRectangle((int)board_x - 14, (int)(board_y + board_height_px * zoom - bar_height),
+                          8, (int)bar_height, Color{255, 80, 80, 255});
+        }
+
+        if (player.game_over) {
+            DrawRectangle((int)board_x, (int)board_y, (int)(board_width_px * zoom), (int)(board_height_px * zoom),
+                          ColorWithAlpha(BLACK, 150));
+        }
+    }
+
+    if (frame.winner >= 0) {
+        DrawRectangle(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, ColorWithAlpha(BLACK, 120));
+
+        const char* result_text = (frame.winner == 2)
+            ? localization.GetText(TextKey::GAME_VERSUS_DRAW)
+            : TextFormat("%s %d %s", localization.GetText(TextKey::GAME_VERSUS_PLAYER), frame.winner + 1,
+                         localization.GetText(TextKey::GAME_VERSUS_WINS));
+        int result_width = MeasureText(result_text, 72);
+        DrawText(result_text, SCREEN_WIDTH / 2 - result_width / 2, SCREEN_HEIGHT / 2 - 50, 72, Color{255, 200, 100, 255});
+
+        const char* esc_text = localization.GetText(TextKey::GAME_OVER_ESC);
+        int esc_width = MeasureText(esc_text, 36);
+        DrawText(esc_text, SCREEN_WIDTH / 2 - esc_width / 2, SCREEN_HEIGHT / 2 + 40, 36, Color{200, 200, 200, 255});
+    }
+}
+
+void Game::CaptureFrozenFrame() {
+    // Ve vnitřním rozlišení plátna - víc detailu by se stejně neukázalo
+    if (!IsRenderTextureValid(frozen_frame)) {
+        frozen_frame = LoadRenderTexture((int)(SCREEN_WIDTH * canvas_scale), (int)(SCREEN_HEIGHT * canvas_scale));
+    }
+    BeginTextureMode(frozen_frame);
+    ClearBackground(BLACK);
+    BeginCanvasCamera(Camera2D{{0, 0}, {0, 0}, 0.0f, 1.0f});
+    DrawGame();
+    EndMode2D();
+    EndTextureMode();
+    frozen_frame_valid = IsRenderTextureValid(frozen_frame);
+}
+
+bool Game::NeedsRedraw() {
+    // Hra, úvod a divák se mění každý tick (stav hry se při běžící simulaci nečte)
+    if ((simulation && simulation->IsRunning()) || camera_changed || IsWindowResized() || state == INTRO_SCREEN || state == SPECTATING || (state == PLAYING && (!game_over || rewinding))) {
+        frames_since_draw = 0;
+        return true;
+    }
+
+    RedrawKey key = {state, main_menu_selected, settings_menu_selected, pause_menu_selected,
+                     GetMenuLabelKey(), game_over, score};
+    // Částice v hlavním menu a FPS čítač stačí obnovovat pomaleji, statický obsah jednou za sekundu
+    int interval = (state == MAIN_MENU || FPS_ENABLED) ? FPS / IDLE_FPS : FPS;
+    if (frames_since_draw < 0 || !(key == last_redraw_key) || frames_since_draw + 1 >= interval) {
+        last_redraw_key = key;
+        frames_since_draw = 0;
+        return true;
+    }
+    frames_since_draw++;
+    return false;
+}
+
 void Game::Draw() {
-    BeginDrawing();
+    // Menu pauzy leží na zmrazeném snímku hry - deska se za ním nepřekresluje
+    if (state != PAUSED) {
+        frozen_frame_valid = false;
+    } else if (!frozen_frame_valid) {
+        CaptureFrozenFrame();
+    }
+
+    // Snímek se kreslí na plátno ve vnitřním rozlišení, do okna jde až zvětšený
+    bool use_canvas = IsRenderTextureValid(canvas);
+    if (use_canvas) {
+        BeginTextureMode(canvas);
+    } else {
+        BeginDrawing();
+    }
     ClearBackground(BLACK);
+    BeginCanvasCamera(Camera2D{{0, 0}, {0, 0}, 0.0f, 1.0f});
 
     switch (state) {
         case INTRO_SCREEN:
@@ -706,8 +1431,21 @@ void Game::Draw() {
         case PLAYING:
             DrawGame();
             break;
-        case PAUSED:
+        case SPECTATING:
             DrawGame();
+            if (!spectator_client->IsConnected()) {
+                const char* waiting = localization.GetText(TextKey::GAME_SPECTATOR_WAITING);
+                DrawText(waiting, SCREEN_WIDTH / 2 - MeasureText(waiting, 36) / 2, SCREEN_HEIGHT / 2, 36, WHITE);
+            }
+            break;
+        case PAUSED:
+            if (frozen_frame_valid) {
+                DrawTexturePro(frozen_frame.texture,
+                               Rectangle{0, 0, (float)frozen_frame.texture.width, -(float)frozen_frame.texture.height},
+                               Rectangle{0, 0, (float)SCREEN_WIDTH, (float)SCREEN_HEIGHT}, Vector2{0, 0}, 0.0f, WHITE);
+            } else {
+                DrawGame();
+            }
             DrawPauseMenu();
             break;
         default:
@@ -715,41 +1453,165 @@ void Game::Draw() {
     }
 
     if (state != INTRO_SCREEN && FPS_ENABLED) {
-        int particle_count = (board && state == PLAYING) ? board->particles.size() : 0;
+        int particle_count = (state == PLAYING || state == SPECTATING) ? drawn_particle_count : 0;
         DrawText(TextFormat("FPS: %d | Particles: %d", GetFPS(), particle_count), 10, 10, 20, Color{0, 255, 0, 255});
+        int overlay_y = 32;
+        if (IsAllocationCountingEnabled()) {
+            DrawText(TextFormat("Allocs/frame: %llu", frame_allocations), 10, overlay_y, 20, Color{0, 255, 0, 255});
+            overlay_y += 22;
+        }
+        if (clip_recorder) {
+            DrawText(TextFormat("Capture drops: %d", clip_recorder->GetDroppedFrames()), 10, overlay_y, 20, Color{0, 255, 0, 255});
+        }
     }
 
+    EndMode2D();
+    if (use_canvas) {
+        EndTextureMode();
+        BeginDrawing();
+        ClearBackground(BLACK);
+        PresentCanvas();
+    }
     EndDrawing();
 }
 
+void Game::CheckTickAllocations(unsigned long long allocations) {
+    if (state != PLAYING) return;
+    alloc_check_tick++;
+    if (alloc_check_tick > ALLOC_CHECK_WARMUP_TICKS && allocations > 0) {
+        alloc_check_count += allocations;
+        TraceLog(LOG_WARNING, "ALLOC: %llu allocations in tick %d", allocations, alloc_check_tick);
+    }
+
+    if (alloc_check_tick < ALLOC_CHECK_WARMUP_TICKS + ALLOC_CHECK_TICKS) {
+        // Bot prohrál dřív, než proběhly všechny ticky - pokračuje se novou hrou
+        // (její vytvoření je mimo měřený tick, zahřátí se neopakuje)
+        if (game_over) NewGame(GameMode::AUTOPLAY);
+        return;
+    }
+
+    if (!IsAllocationCountingEnabled()) {
+        TraceLog(LOG_ERROR, "ALLOC: Allocation counting is disabled (build with DEBUG or --count-allocations)");
+        alloc_check_failed = true;
+    } else if (alloc_check_count > 0) {
+        TraceLog(LOG_ERROR, "ALLOC: %llu allocations in %d ticks after warm-up", alloc_check_count, ALLOC_CHECK_TICKS);
+        alloc_check_failed = true;
+    } else {
+        TraceLog(LOG_INFO, "ALLOC: No allocations in %d ticks after warm-up", ALLOC_CHECK_TICKS);
+    }
+    should_exit = true;
+}
+
 void Game::Run() {
+    // Okno jde zvětšit i na HiDPI - hra se kreslí na plátno a to se do okna jen zvětší
+    SetConfigFlags(FLAG_WINDOW_RESIZABLE | FLAG_WINDOW_HIGHDPI);
     InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, GAME_NAME.c_str());
     SetExitKey(KEY_NULL);
-    SetTargetFPS(FPS);
+    // Tempo smyčky řídí Run sám, aby mohl mezi ticky vzorkovat vstupy
+    SetTargetFPS(0);
+    PrepareCanvas();
+    PrepareGradientBackground(BG_COLOR_TOP, BG_COLOR_BOTTOM);
+    grain_atlas.Load();
 
-    InitAudioDevice();
-    Music music = LoadMusicStream("assets/music.ogg");
-    SetMusicVolume(music, 1.0f);
+    // Audio zařízení a assety se připravují na pozadí, úvod se mezitím už kreslí
+    assets = new Assets();
+    assets->StartLoading(*thread_pool);
 
-    if (MUSIC_ENABLED) PlayMusicStream(music);
+    // Režim diváka přeskočí úvod i menu
+    if (!SPECTATOR_VIEW_PATH.empty()) StartSpectating();
 
+    // Kontrola alokací hraje rovnou bota, bez vlákna simulace (ticky se měří v této smyčce)
+    if (ALLOC_CHECK_TICKS > 0) NewGame(GameMode::AUTOPLAY);
+
+    if (THREADED_SIMULATION && ALLOC_CHECK_TICKS == 0) simulation = new SimulationThread([this] { SimulationTick(); }, FPS);
+
+    bool first_frame = true;
+    double next_tick = GetTime();
     while (!WindowShouldClose() && !should_exit) {
         UpdateGamepad();
+        input.BeginTick(GetTime());
+        if (versus) {
+            for (InputSystem& player_input : versus_inputs) player_input.BeginTick(GetTime());
+        }
         HandleInput();
-        Update();
-        Draw();
+        UpdateBoardCamera();
+
+        if (simulation && state == PLAYING && !simulation->IsRunning()) {
+            // Ovládání z doby před spuštěním už neplatí, kreslit se začne od aktuálního stavu
+            TickInput stale;
+            while (tick_inputs.Pop(stale)) {}
+            CaptureGameFrame(frames.GetWriteBuffer());
+            frames.Publish();
+            simulation->Start();
+        }
+        if (!simulation || !simulation->IsRunning()) {
+            unsigned long long tick_start = GetAllocationCount();
+            Update();
+            if (ALLOC_CHECK_TICKS > 0) CheckTickAllocations(GetAllocationCount() - tick_start);
+        }
 
-        if (MUSIC_ENABLED && !IsMusicStreamPlaying(music)) {
-            PlayMusicStream(music);
-        } else if (!MUSIC_ENABLED && IsMusicStreamPlaying(music)) {
-            StopMusicStream(music);
+        if (NeedsRedraw()) {
+            Draw();
+        } else {
+            // Beze změny - jen načíst události okna (EndDrawing to tentokrát neudělá)
+            PollInputEvents();
+        }
+
+        // Do dalšího ticku vzorkovat vstupy, ať stisky dostanou přesný čas
+        next_tick += 1.0 / FPS;
+        double now = GetTime();
+        if (now > next_tick || ALLOC_CHECK_TICKS > 0) next_tick = now;  // Zpožděný tick se nedohání, kontrola alokací nečeká
+        while (now < next_tick) {
+            WaitTime(std::min(INPUT_SAMPLE_MS / 1000.0, next_tick - now));
+            PollInputEvents();
+            now = GetTime();
+            input.Sample(now);
+            if (versus) {
+                for (InputSystem& player_input : versus_inputs) player_input.Sample(now);
+            }
+        }
+
+        if (first_frame) {
+            double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startup_time).count();
+            TraceLog(LOG_INFO, "STARTUP: First frame after %.1f ms", elapsed);
+            first_frame = false;
         }
+        if (!audio_thread && assets->IsReady()) StartAudio();
+
+        // Alokace celého snímku (herní tick, kreslení i ostatní vlákna) pro FPS čítač
+        unsigned long long allocation_count = GetAllocationCount();
+        frame_allocations = allocation_count - frame_allocation_mark;
+        frame_allocation_mark = allocation_count;
+    }
+
+    if (simulation) {
+        simulation->Stop();
+    }
 
-        if (IsMusicStreamPlaying(music)) UpdateMusicStream(music);
+    // Kontrola alokací přerušená dřív (zavřené okno) nic neověřila
+    if (ALLOC_CHECK_TICKS > 0 && alloc_check_tick < ALLOC_CHECK_WARMUP_TICKS + ALLOC_CHECK_TICKS) {
+        TraceLog(LOG_ERROR, "ALLOC: Check interrupted after %d of %d ticks",
+                 std::max(0, alloc_check_tick - ALLOC_CHECK_WARMUP_TICKS), ALLOC_CHECK_TICKS);
+        alloc_check_failed = true;
     }
 
-    // Cleanup před zavřením okna
-    UnloadMusicStream(music);
-    CloseAudioDevice();
+    // Automatické uložení rozehrané hry při ukončení
+    if (state == PLAYING || state == PAUSED) SaveGame();
+
+    // Cleanup před zavřením okna (při ukončení během úvodu počkat na načítání)
+    thread_pool->Wait();
+    delete simulation;
+    simulation = nullptr;
+    delete audio_thread;
+    audio_thread = nullptr;
+    delete sfx_mixer;
+    sfx_mixer = nullptr;
+    if (IsAudioDeviceReady()) CloseAudioDevice();
+    delete assets;
+    assets = nullptr;
+    if (IsRenderTextureValid(frozen_frame)) UnloadRenderTexture(frozen_frame);
+    if (IsRenderTextureValid(canvas)) UnloadRenderTexture(canvas);
+    if (IsRenderTextureValid(background_texture)) UnloadRenderTexture(background_texture);
+    grain_atlas.Unload();
     CloseWindow();
 }
@@ -6,6 +6,95 @@
 #include "Tetromino.hpp"
 #include "Intro.hpp"
 #include "Localization.hpp"
+#include "Bot.hpp"
+#include "ThreadPool.hpp"
+#include "TaskGraph.hpp"
+#include "FrameRecorder.hpp"
+#include "ClipRecorder.hpp"
+#include "RewindBuffer.hpp"
+#include "SpectatorStream.hpp"
+#include "AudioThread.hpp"
+#include "SfxMixer.hpp"
+#include "Assets.hpp"
+#include "InputSystem.hpp"
+#include "SimulationThread.hpp"
+#include "TripleBuffer.hpp"
+#include "SpscQueue.hpp"
+#include "Versus.hpp"
+#include <chrono>
+#include <string>
+
+/**
+ * Položky hlavního menu. "Pokračovat" se zobrazuje jen pokud existuje uložená hra.
+ */
+enum class MainMenuItem { CONTINUE, NEW_GAME, PRACTICE, AUTOPLAY, VERSUS, SETTINGS, EXIT };
+
+/**
+ * Naformátovaný a změřený text položky menu (přepočítá se jen při změně jazyka nebo nastavení).
+ */
+struct MenuLabel {
+    char text[128];    // Hotový text
+    int width;         // Šířka textu v pixelech pro jeho velikost písma
+};
+
+/**
+ * Hodnoty, ze kterých se skládají texty menu - při jejich změně se texty přestaví.
+ */
+struct MenuLabelKey {
+    unsigned int language_revision;  // Revize překladů (Localization::GetRevision)
+    int gamepad;                     // Připojený gamepad (-1 = žádný)
+    bool music, sfx, fps;            // Přepínače nastavení
+    bool has_saved_game;             // Zobrazuje se "Pokračovat"
+
+    bool operator==(const MenuLabelKey& other) const {
+        return language_revision == other.language_revision && gamepad == other.gamepad &&
+               music == other.music && sfx == other.sfx && fps == other.fps &&
+               has_saved_game == other.has_saved_game;
+    }
+};
+
+/**
+ * Snímek jedné hrací plochy - deska, kostky a skóre hráče.
+ */
+struct PlayerFrame {
+    BoardFrame board;                // Snímek desky
+    bool has_board;                  // Deska existuje
+    std::vector<Particle> current_piece;  // Částice padající kostky (prázdné = žádná)
+    bool has_next;                   // Náhled další kostky existuje
+    int next_shape;                  // Tvar další kostky
+    Color next_color;                // Barva další kostky
+    int score;                       // Skóre
+    bool game_over;                  // Konec hry
+    int garbage;                     // Písek čekající na shození na desku (souboj)
+};
+
+/**
+ * Snímek herní obrazovky pro vykreslení - vzniká po ticku simulace,
+ * kreslí se bez přístupu k živé desce a kostkám. Hrací plocha hráče
+ * (v souboji levého) je přímo v PlayerFrame.
+ */
+struct GameFrame : PlayerFrame {
+    bool versus;                     // Souboj dvou hráčů
+    PlayerFrame rival;               // Pravý hráč souboje
+    int winner;                      // Vítěz souboje (-1 = hraje se, 2 = remíza)
+};
+
+/**
+ * Hodnoty určující obsah nečinné obrazovky - při jejich změně se snímek překreslí.
+ */
+struct RedrawKey {
+    GameState state;                 // Zobrazená obrazovka
+    int main_selected, settings_selected, pause_selected;  // Vybrané položky menu
+    MenuLabelKey labels;             // Jazyk a nastavení
+    bool game_over;                  // Zobrazuje se konec hry
+    int score;                       // Skóre na obrazovce konce hry
+
+    bool operator==(const RedrawKey& other) const {
+        return state == other.state && main_selected == other.main_selected &&
+               settings_selected == other.settings_selected && pause_selected == other.pause_selected &&
+               labels == other.labels && game_over == other.game_over && score == other.score;
+    }
+};
 
 /**
  * Hlavní herní třída řídící stav hry, vstupy a vykreslování.
@@ -15,24 +104,86 @@
 class Game {
 public:
     GameState state;                 // Aktuální stav hry (menu, hra, pauza atd.)
+    GameMode mode;                   // Herní režim (hráč / bot)
     Board* board;                    // Herní deska se systémem částic
     Tetromino* current_tetromino;    // Aktuálně padající tetromino
     Tetromino* next_tetromino;       // Náhled dalšího tetromina
+    Versus* versus;                  // Souboj dvou hráčů (nullptr mimo souboj - board a kostky pak nejsou)
     Intro* intro;                    // Úvodní animace při startu
+    ThreadPool* thread_pool;         // Pracovní vlákna pro paralelní výpočty
+    Bot* bot;                        // Automatický hráč pro režim AUTOPLAY
+    BotPlacement bot_target;         // Cílové umístění aktuální kostky vybrané botem
+    bool bot_has_target;             // Příznak, zda bot už pro aktuální kostku rozhodl
+    FrameRecorder* frame_recorder;   // Záznam historie desky po ticích (nullptr = vypnuto)
+    int recorded_games;              // Počet her zaznamenaných přes --record-frames (číslo souboru)
+    ClipRecorder* clip_recorder;     // Záznam hry do GIF / PNG (--capture, vzniká s prvním snímkem desky)
+    RewindBuffer* rewind_buffer;     // Historie pro přetáčení v tréninku (nullptr mimo trénink)
+    bool rewinding;                  // Hráč právě drží přetáčení zpět
+    SpectatorPublisher* spectator_publisher;  // Vysílání hry divákům (nullptr = vypnuto)
+    SpectatorClient* spectator_client;        // Příjem vysílání v režimu diváka (nullptr = běžná hra)
+    int spectator_retry_counter;              // Framy do dalšího pokusu o připojení diváka
+    AudioThread* audio_thread;       // Hudba dekódovaná mimo herní smyčku (vznikne po načtení assetů)
+    SfxMixer* sfx_mixer;             // Zvukové efekty (vznikne po načtení assetů)
+    Assets* assets;                  // Assety načítané na pozadí (existuje během Run)
+    std::chrono::steady_clock::time_point startup_time;  // Okamžik spuštění (měření startu)
+    int explosion_group_size;        // Počet částic probíhajícího výbuchu (síla zvuku)
+    int landing_cooldown;            // Ticky do dalšího možného zvuku dopadu
 
     int score;                       // Skóre hráče
     bool game_over;                  // Příznak konce hry
     int fall_counter;                // Počítadlo pro automatický pád tetromina
     int current_fall_speed;          // Aktuální rychlost pádu (snižuje se s vyšším skóre)
     bool waiting_for_settlement;     // Čeká na usazení částic před spawnem nového tetromina
-    int offset_x, offset_y;          // Posun desky na obrazovce
+    Camera2D board_camera;           // Umístění a měřítko desky na obrazovce (viz LayoutBoard)
+    Rectangle board_viewport;        // Plocha obrazovky pro desku (celá deska při camera_zoom 1)
+    float camera_zoom;               // Přiblížení zvolené hráčem (1 = celá deska)
+    Vector2 camera_center;           // Střed pohledu v souřadnicích desky (pixely)
+    bool camera_follow;              // Pohled sleduje padající kostku
+    bool camera_changed;             // Pohled se od posledního vykreslení změnil
 
-    int move_counter_left, move_counter_right, move_counter_down;  // Zpoždění pro plynulé pohyby
     int main_menu_selected, settings_menu_selected, pause_menu_selected;  // Vybrané položky v menu
 
     int active_gamepad;              // ID aktivního gamepadu (-1 pokud není připojen)
-    int gamepad_menu_delay;          // Zpoždění pro navigaci v menu gamepadem
-    int gamepad_move_delay_left, gamepad_move_delay_right;  // Zpoždění pro pohyb gamepadem
+    InputSystem input;               // Vzorkování vstupů s časovými razítky a opakováním (DAS/ARR)
+    InputSystem versus_inputs[2];    // Ovládání hráčů souboje (WASD + gamepad 0, šipky + gamepad 1)
+
+    SimulationThread* simulation;    // Vlákno simulace (nullptr = simulace v hlavní smyčce)
+    SpscQueue<TickInput, 64> tick_inputs;  // Ovládání čekající na vlákno simulace
+    TripleBuffer<GameFrame> frames;  // Snímky z vlákna simulace pro vykreslení
+    GameFrame live_frame;            // Snímek zachycený v hlavním vlákně (bez vlákna simulace)
+    int drawn_particle_count;        // Počet částic posledního vykresleného snímku (FPS čítač)
+
+    TaskGraph* update_graph;         // Fáze ticku desky se závislostmi (gravitace, výbuchy, spojení)
+    int connections_removed;         // Výsledek kontroly spojení v posledním ticku
+
+    std::string save_path;           // Cesta k souboru s automaticky uloženou hrou
+    bool has_saved_game;             // Existuje uložená hra k pokračování
+    int board_width_setting;         // Šířka desky z --board (BOARD_WIDTH je rozměr aktuální hry)
+    int board_height_setting;        // Výška desky z --board (BOARD_HEIGHT je rozměr aktuální hry)
+
+    MenuLabel main_menu_labels[7];   // Položky hlavního menu
+    int main_menu_label_count;       // Počet položek hlavního menu
+    MenuLabel settings_title_label, settings_info_label, settings_back_label;  // Texty nastavení
+    MenuLabel settings_menu_labels[8];  // Položky nastavení
+    MenuLabel pause_title_label;     // Nadpis pauzy
+    MenuLabel pause_menu_labels[3];  // Položky pauzy
+    MenuLabelKey menu_labels_key;    // Hodnoty, ze kterých vznikly aktuální texty
+    bool menu_labels_valid;          // Texty menu už byly sestaveny
+
+    RenderTexture2D background_texture;  // Předkreslený gradient pozadí
+    Color background_top, background_bottom;  // Barvy předkresleného gradientu
+    RenderTexture2D frozen_frame;    // Zmrazený snímek hry za menu pauzy
+    bool frozen_frame_valid;         // frozen_frame odpovídá aktuální pauze
+    RenderTexture2D canvas;          // Plátno ve vnitřním rozlišení (RENDER_SCALE), do okna se zvětšuje
+    float canvas_scale;              // Měřítko kreslení na plátno (1 bez plátna - kreslí se rovnou do okna)
+    Rectangle canvas_dest;           // Umístění plátna v okně (souřadnice okna)
+    RedrawKey last_redraw_key;       // Obsah posledního vykresleného snímku
+    int frames_since_draw;           // Ticky od posledního vykreslení (-1 = ještě nekresleno)
+    unsigned long long frame_allocation_mark;  // Počet alokací na začátku snímku
+    unsigned long long frame_allocations;      // Alokace za poslední snímek (FPS čítač)
+    int alloc_check_tick;                      // Odehrané herní ticky kontroly alokací (--alloc-check)
+    unsigned long long alloc_check_count;      // Alokace v herních ticích po zahřátí
+    bool alloc_check_failed;                   // Kontrola alokací selhala
 
 private:
     bool should_exit;  // Příznak požadavku na ukončení aplikace
@@ -50,14 +201,112 @@ public:
 
     /**
      * Inicializuje novou hru (resetuje skóre, vytvoří novou desku).
+     * @param new_mode Herní režim nové hry
+     * @param board_width Šířka desky v buňkách (0 = podle --board)
+     * @param board_height Výška desky v buňkách (0 = podle --board)
      */
-    void NewGame();
+    void NewGame(GameMode new_mode = GameMode::NORMAL, int board_width = 0, int board_height = 0);
 
     /**
      * Vytvoří nové tetromino a umístí ho na vrchol desky.
      */
     void SpawnTetromino();
 
+    /**
+     * Uloží rozehranou hru (volá se při pauze a při ukončení).
+     * Hry bota se neukládají, aby nepřepsaly uložení hráče.
+     */
+    void SaveGame();
+
+    /**
+     * Obnoví hru z uloženého snímku a přejde do herního stavu.
+     * @return true pokud se hru podařilo načíst
+     */
+    bool LoadSavedGame();
+
+    /**
+     * Smaže uloženou hru (po konci hry).
+     */
+    void DeleteSavedGame();
+
+    /**
+     * @return Aktuální herní hodnoty mimo desku (pro přetáčení)
+     */
+    RewindState GetRewindState() const;
+
+    /**
+     * Obnoví herní hodnoty a obě kostky ze stavu přetáčení.
+     * @param rewind_state Cílový stav
+     */
+    void ApplyRewindState(const RewindState& rewind_state);
+
+    /**
+     * Přetočí hru o jeden tick zpět (volá se každý frame, dokud hráč drží klávesu).
+     */
+    void UpdateRewind();
+
+    /**
+     * Spustí hudbu a zvukové efekty, jakmile jsou assety načtené.
+     */
+    void StartAudio();
+
+    /**
+     * Přehraje zvukový efekt, pokud jsou efekty zapnuté.
+     * @param id Efekt
+     * @param intensity Síla 0.0 - 1.0
+     */
+    void PlaySfx(SfxId id, float intensity = 1.0f);
+
+    /**
+     * Odešle divákům stav na konci minulého ticku (volá se na začátku Update).
+     */
+    void PublishSpectatorFrame();
+
+    /**
+     * Přepne hru do režimu diváka - deska a kostky se jen kreslí podle streamu.
+     */
+    void StartSpectating();
+
+    /**
+     * Přečte nová data ze streamu a přenese je na desku a kostky.
+     */
+    void UpdateSpectator();
+
+    /**
+     * Sestaví aktuální položky hlavního menu.
+     * @param items Výstupní pole (alespoň 7 položek)
+     * @return Počet položek
+     */
+    int GetMainMenuItems(MainMenuItem* items) const;
+
+    /**
+     * @return Aktuální hodnoty, ze kterých se skládají texty menu
+     */
+    MenuLabelKey GetMenuLabelKey() const;
+
+    /**
+     * Přestaví texty menu, pokud se od minula změnil jazyk nebo nastavení.
+     */
+    void UpdateMenuLabels();
+
+    /**
+     * Naformátuje text položky a změří jeho šířku.
+     * @param label Výstupní položka
+     * @param font_size Velikost písma pro měření
+     * @param format Formát pro vsnprintf
+     */
+    static void FormatMenuLabel(MenuLabel& label, int font_size, const char* format, ...);
+
+    /**
+     * Vykreslí vycentrované položky menu se zvýrazněním vybrané.
+     * @param labels Položky
+     * @param count Počet položek
+     * @param selected Index vybrané položky
+     * @param y_start Y první položky
+     * @param y_spacing Rozestup položek
+     */
+    void DrawMenuLabels(const MenuLabel* labels, int count, int selected, int y_start, int y_spacing);
+
     /**
      * Detekuje a aktualizuje aktivní gamepad.
      */
@@ -68,11 +317,81 @@ public:
      */
     void HandleInput();
 
+    /**
+     * Přečte ovládání kostky pro tento tick (hlavní vlákno).
+     * @param player_input Vstupy hráče (input, v souboji versus_inputs)
+     * @return Ovládání pro ApplyTickInput
+     */
+    TickInput ReadTickInput(InputSystem& player_input);
+
+    /**
+     * Provede ovládání kostky - rotaci, posun, rychlý pád a přetáčení.
+     * @param tick_input Ovládání z ReadTickInput
+     */
+    void ApplyTickInput(const TickInput& tick_input);
+
+    /**
+     * Jeden tick na vlákně simulace - převezme ovládání, aktualizuje hru a zveřejní snímek.
+     */
+    void SimulationTick();
+
+    /**
+     * Zkopíruje stav hry do snímku pro vykreslení.
+     * @param frame Výstupní snímek
+     */
+    void CaptureGameFrame(GameFrame& frame);
+
+    /**
+     * @return Snímek ke kreslení - poslední hotový snímek simulace, nebo aktuální stav
+     */
+    const GameFrame& AcquireGameFrame();
+
     /**
      * Aktualizuje herní logiku (pohyb tetromina, fyzika, detekce výbuchů).
      */
     void Update();
 
+    /**
+     * Sestaví graf fází ticku desky - nezávislé fáze pak běží souběžně na poolu.
+     */
+    void BuildUpdateGraph();
+
+    /**
+     * Ovládání tetromina botem - rotace a posun k cílovému umístění, pak rychlý pád.
+     */
+    void UpdateBot();
+
+    /**
+     * Předkreslí gradient pozadí do textury (volá se po vytvoření okna).
+     * @param top Barva v horní části obrazovky
+     * @param bottom Barva ve spodní části obrazovky
+     */
+    void PrepareGradientBackground(Color top, Color bottom);
+
+    /**
+     * Vytvoří plátno ve vnitřním rozlišení (po vytvoření okna). Bez podpory
+     * render textur (OpenGL 1.1) se kreslí rovnou do okna pevné velikosti.
+     */
+    void PrepareCanvas();
+
+    /**
+     * Začne kreslení kamerou v souřadnicích hry - přidá k ní měřítko plátna.
+     * BeginMode2D nejde vnořit, kamera desky proto jde přes tuto metodu.
+     * @param camera Kamera v souřadnicích obrazovky hry (SCREEN_WIDTH × SCREEN_HEIGHT)
+     */
+    void BeginCanvasCamera(Camera2D camera);
+
+    /**
+     * Ukončí kameru z BeginCanvasCamera a vrátí samotné měřítko plátna.
+     */
+    void EndCanvasCamera();
+
+    /**
+     * Zvětší plátno do okna - celočíselně bez vyhlazování a na střed, menší
+     * okno plátno zmenší celé. Volá se mezi BeginDrawing a EndDrawing.
+     */
+    void PresentCanvas();
+
     /**
      * Vykreslí gradientní pozadí.
      * @param top Barva v horní části obrazovky
@@ -81,7 +400,7 @@ public:
     void DrawGradientBackground(Color top, Color bottom);
 
     /**
-     * Vykreslí hlavní menu s možnostmi Start, Settings, Exit.
+     * Vykreslí hlavní menu s možnostmi Continue, Start, Practice, Autoplay, Settings, Exit.
      */
     void DrawMainMenu();
 
@@ -95,18 +414,70 @@ public:
      */
     void DrawPauseMenu();
 
+    /**
+     * Rozmístí desku na obrazovce: vlevo od panelu se skóre, zmenšenou tak,
+     * aby se vešla celá (klasická deska 1:1).
+     */
+    void LayoutBoard();
+
+    /**
+     * Ovládání pohledu na desku: kolečko myši a +/- přibližují, tažení pravým
+     * tlačítkem posouvá a Home vrací sledování padající kostky.
+     */
+    void UpdateBoardCamera();
+
+    /**
+     * Kamera pro vykreslení snímku - při sledování se plynule posune ke kostce
+     * a střed se omezí tak, aby pohled nevyjel mimo desku.
+     * @param frame Vykreslovaný snímek
+     * @return Kamera desky včetně přiblížení
+     */
+    Camera2D FrameBoardCamera(const GameFrame& frame);
+
     /**
      * Vykreslí herní obrazovku (desku, tetromina, skóre).
      */
     void DrawGame();
 
+    /**
+     * Vykreslí souboj - desky obou hráčů vedle sebe, skóre, čekající písek a vítěze.
+     * @param frame Vykreslovaný snímek
+     */
+    void DrawVersus(const GameFrame& frame);
+
+    /**
+     * Vykreslí herní obrazovku do textury, nad kterou se kreslí menu pauzy.
+     */
+    void CaptureFrozenFrame();
+
+    /**
+     * Rozhodne, zda se má v tomto ticku kreslit. Hra a úvod se kreslí každý tick,
+     * nečinné obrazovky (menu, pauza, konec hry) jen při změně obsahu, animované
+     * menu a FPS čítač rychlostí IDLE_FPS, jinak jednou za sekundu.
+     * @return true pokud se má snímek vykreslit
+     */
+    bool NeedsRedraw();
+
     /**
      * Hlavní vykreslovací metoda - volá odpovídající draw funkci podle aktuálního stavu.
      */
     void Draw();
 
+    /**
+     * Započítá alokace jednoho herního ticku do kontroly --alloc-check. Po zahřátí
+     * musí být ticky bez alokací; prohraná hra se nahradí novou, dokud neproběhne
+     * ALLOC_CHECK_TICKS ticků. Pak kontrola vypíše výsledek a ukončí aplikaci.
+     * @param allocations Počet alokací během ticku
+     */
+    void CheckTickAllocations(unsigned long long allocations);
+
     /**
      * Spustí hlavní herní smyčku.
      */
     void Run();
+
+    /**
+     * @return true pokud kontrola alokací (--alloc-check) selhala
+     */
+    bool AllocationCheckFailed() const { return alloc_check_failed; }
 };
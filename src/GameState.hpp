@@ -10,5 +10,16 @@ enum GameState {
     SETTINGS,           // Menu nastavení (hudba)
     PLAYING,            // Aktivní herní stav
     PAUSED,             // Pauza (Resume, Restart, Main Menu)
-    GAME_OVER_STATE     // Obrazovka game over se skóre
+    GAME_OVER_STATE,    // Obrazovka game over se skóre
+    SPECTATING          // Divák - vykresluje cizí hru ze streamu (--spectate)
+};
+
+/**
+ * Herní režim - určuje, kdo ovládá padající tetromino.
+ */
+enum class GameMode {
+    NORMAL,             // Hráč ovládá kostky
+    PRACTICE,           // Trénink - hráč může hru přetáčet zpět
+    AUTOPLAY,           // Kostky ovládá bot (prohledávání umístění)
+    VERSUS              // Souboj dvou hráčů na jedné obrazovce (viz Versus)
 };
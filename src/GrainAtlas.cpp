@@ -0,0 +1,89 @@
+#include "GrainAtlas.hpp"
+#include "Constants.hpp"
+#include "Utils.hpp"
+#include <algorithm>
+#include <cmath>
+
+// Globální instance
+GrainAtlas grain_atlas;
+
+namespace {
+// Dlaždice jsou od sebe o pixel odsazené, ať se při zvětšení nenačte soused
+constexpr int TILE_STRIDE = PARTICLE_SIZE + 1;
+constexpr int COLUMN_COUNT = GrainAtlas::ENHANCED + GrainAtlas::ENHANCED_LEVELS;
+
+// Obdélník obrysu zrna - stejné pixely jako DrawRectangleLines v Particle::Draw
+void DrawTileOutline(Image& image, int x, int y, Color color) {
+    ImageDrawRectangle(&image, x, y, PARTICLE_SIZE, 1, color);
+    ImageDrawRectangle(&image, x, y + PARTICLE_SIZE - 1, PARTICLE_SIZE, 1, color);
+    ImageDrawRectangle(&image, x, y, 1, PARTICLE_SIZE, color);
+    ImageDrawRectangle(&image, x + PARTICLE_SIZE - 1, y, 1, PARTICLE_SIZE, color);
+}
+}
+
+GrainAtlas::GrainAtlas() : texture() {}
+
+void GrainAtlas::Load() {
+    if (texture.id != 0) return;
+
+    Image image = GenImageColor(COLUMN_COUNT * TILE_STRIDE, PALETTE_SIZE * TILE_STRIDE, BLANK);
+    for (int row = 0; row < PALETTE_SIZE; row++) {
+        Color color = ALL_COLORS[row];
+        int y = row * TILE_STRIDE;
+
+        // Běžné zrno - výplň, světlo nahoře a vlevo, stín dole a vpravo
+        int x = NORMAL * TILE_STRIDE;
+        Color highlight = BrightenColor(color, 1.3f);
+        Color shadow = DarkenColor(color, 0.7f);
+        ImageDrawRectangle(&image, x, y, PARTICLE_SIZE, PARTICLE_SIZE, color);
+        ImageDrawRectangle(&image, x, y, PARTICLE_SIZE, 1, highlight);
+        ImageDrawRectangle(&image, x, y, 1, PARTICLE_SIZE, highlight);
+        ImageDrawRectangle(&image, x, y + PARTICLE_SIZE - 1, PARTICLE_SIZE, 1, shadow);
+        ImageDrawRectangle(&image, x + PARTICLE_SIZE - 1, y, 1, PARTICLE_SIZE, shadow);
+
+        // Náhled - výplň a světlo
+        x = PREVIEW * TILE_STRIDE;
+        ImageDrawRectangle(&image, x, y, PARTICLE_SIZE, PARTICLE_SIZE, color);
+        ImageDrawRectangle(&image, x, y, PARTICLE_SIZE, 1, highlight);
+        ImageDrawRectangle(&image, x, y, 1, PARTICLE_SIZE, highlight);
+
+        // Záře - plná barva, průhlednost dodá tint
+        ImageDrawRectangle(&image, GLOW * TILE_STRIDE, y, PARTICLE_SIZE, PARTICLE_SIZE, color);
+
+        // Enhanced zrna - jas výplně i obrysu roste se zvětšením (vzorce z Particle::Draw)
+        for (int level = 0; level < ENHANCED_LEVELS; level++) {
+            float scale = 1.0f + level * ENHANCED_STEP;
+            x = (ENHANCED + level) * TILE_STRIDE;
+            ImageDrawRectangle(&image, x, y, PARTICLE_SIZE, PARTICLE_SIZE, BrightenColor(color, 1.2f + (scale - 1.0f) * 0.5f));
+            DrawTileOutline(image, x, y, BrightenColor(color, 1.4f + (scale - 1.0f) * 0.8f));
+        }
+    }
+
+    texture = LoadTextureFromImage(image);
+    UnloadImage(image);
+}
+
+void GrainAtlas::Unload() {
+    if (texture.id == 0) return;
+    UnloadTexture(texture);
+    texture = {};
+}
+
+bool GrainAtlas::DrawGrain(Color color, int column, float x, float y, float size, Color tint) const {
+    if (texture.id == 0) return false;
+    int row = GetColorIndex(color);
+    if (row < 0) return false;
+
+    Rectangle source = {(float)(column * TILE_STRIDE), (float)(row * TILE_STRIDE), (float)PARTICLE_SIZE, (float)PARTICLE_SIZE};
+    if (size == PARTICLE_SIZE) {
+        DrawTextureRec(texture, source, Vector2{x, y}, tint);
+    } else {
+        DrawTexturePro(texture, source, Rectangle{x, y, size, size}, Vector2{0, 0}, 0.0f, tint);
+    }
+    return true;
+}
+
+int GrainAtlas::EnhancedColumn(float scale) {
+    int level = (int)std::lround((scale - 1.0f) / ENHANCED_STEP);
+    return ENHANCED + std::clamp(level, 0, ENHANCED_LEVELS - 1);
+}
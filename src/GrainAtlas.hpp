@@ -0,0 +1,66 @@
+#pragma once
+
+#include "raylib.h"
+
+/**
+ * Atlas předstínovaných dlaždic zrn - jeden řádek na barvu palety ALL_COLORS,
+ * ve sloupcích varianty (běžné zrno se světlem a stínem, náhled, záře a
+ * enhanced zrno pro několik stupňů zvětšení výbuchu).
+ *
+ * Zrno se pak kreslí jedním obdélníkem z textury místo obdélníku a čtyř čar
+ * se stínováním počítaným pro každé zrno. Všechna zrna sdílí jednu texturu,
+ * raylib je tak pošle v jedné dávce. Barvy mimo paletu atlas nezná - volající
+ * je kreslí postaru.
+ */
+class GrainAtlas {
+public:
+    static constexpr int ENHANCED_LEVELS = 7;      // Stupně zvětšení enhanced dlaždic (1.0 - 1.6)
+    static constexpr float ENHANCED_STEP = 0.1f;   // Rozdíl zvětšení mezi stupni
+
+    /**
+     * Sloupce atlasu - ENHANCED + stupeň z EnhancedColumn.
+     */
+    enum Column {
+        NORMAL,     // Zrno na desce (světlo nahoře a vlevo, stín dole a vpravo)
+        PREVIEW,    // Zrno náhledu další kostky (jen světlo)
+        GLOW,       // Plná barva pro záři kolem zvětšeného zrna (průhlednost přes tint)
+        ENHANCED    // Padající kostka a zrna před výbuchem (světlejší výplň a obrys)
+    };
+
+    GrainAtlas();
+
+    /**
+     * Vygeneruje atlas a nahraje ho jako texturu (hlavní vlákno, po InitWindow).
+     */
+    void Load();
+
+    /**
+     * Uvolní texturu atlasu (před CloseWindow).
+     */
+    void Unload();
+
+    /**
+     * Vykreslí zrno z atlasu.
+     * @param color Barva zrna (musí být z palety)
+     * @param column Sloupec atlasu (Column, u ENHANCED přes EnhancedColumn)
+     * @param x Levý okraj v pixelech
+     * @param y Horní okraj v pixelech
+     * @param size Velikost vykresleného zrna v pixelech
+     * @param tint Tint dlaždice (alfa u záře)
+     * @return false pokud atlas není načtený nebo barva není v paletě (nic se nevykreslilo)
+     */
+    bool DrawGrain(Color color, int column, float x, float y, float size, Color tint = WHITE) const;
+
+    /**
+     * Sloupec enhanced dlaždice nejbližší zadanému zvětšení.
+     * @param scale Zvětšení zrna (1.0 = normální)
+     * @return Sloupec atlasu
+     */
+    static int EnhancedColumn(float scale);
+
+private:
+    Texture2D texture;   // Textura atlasu (id 0 = nenačteno)
+};
+
+// Globální atlas zrn (kreslí Particle::Draw a náhled kostky)
+extern GrainAtlas grain_atlas;
@@ -0,0 +1,85 @@
+#include "GridCodec.hpp"
+#include "Constants.hpp"
+#include "Utils.hpp"
+#include <algorithm>
+
+unsigned char EncodeCell(const Particle& p) {
+    unsigned char cell = (unsigned char)(std::max(0, GetColorIndex(p.color)) + 1);
+    if (p.settled) cell |= CELL_SETTLED;
+    return cell;
+}
+
+Color CellColor(unsigned char cell) {
+    int index = std::min((cell & CELL_COLOR_MASK) - 1, PALETTE_SIZE - 1);
+    return ALL_COLORS[std::max(0, index)];
+}
+
+void CaptureCells(const Board& board, std::vector<unsigned char>& cells) {
+    cells.assign(board.width * board.height, CELL_EMPTY);
+    for (auto p : board.particles) {
+        int px = (int)p->x;
+        int py = (int)p->y;
+        if (px >= 0 && px < board.width && py >= 0 && py < board.height) {
+            cells[py * board.width + px] = EncodeCell(*p);
+        }
+    }
+}
+
+void CaptureGridRow(const Board& board, int y, unsigned char* row) {
+    const std::vector<Particle*>& grid_row = board.grid[y];
+    for (int x = 0; x < board.width; x++) {
+        row[x] = grid_row[x] ? EncodeCell(*grid_row[x]) : CELL_EMPTY;
+    }
+}
+
+void EncodeRowRLE(const unsigned char* row, int width, std::vector<unsigned char>& out) {
+    int x = 0;
+    while (x < width) {
+        unsigned char value = row[x];
+        int run = 1;
+        while (x + run < width && run < 16 && row[x + run] == value) run++;
+        out.push_back((unsigned char)((value << 4) | (run - 1)));
+        x += run;
+    }
+}
+
+const unsigned char* DecodeRowRLE(const unsigned char* data, const unsigned char* end, unsigned char* row, int width) {
+    int x = 0;
+    while (x < width) {
+        if (data >= end) return nullptr;
+        unsigned char value = *data >> 4;
+        int run = (*data & 0x0F) + 1;
+        data++;
+        if (x + run > width) return nullptr;
+        std::fill(row + x, row + x + run, value);
+        x += run;
+    }
+    return data;
+}
+
+void RestoreBoardFromCells(Board& board, const unsigned char* cells) {
+    // Rozpracovaný výbuch odkazuje na staré částice - zrušit ho
+    board.particles_to_explode.clear();
+    board.explosion_scale = 1.0f;
+    board.exploding_groups.clear();
+    board.explosion_state = Board::ExplosionState::NONE;
+    board.pending_disturbances.clear();
+    board.disturbance_cursor = 0;
+
+    for (auto p : board.particles) board.ReleaseParticle(p);
+    board.particles.clear();
+
+    for (int y = 0; y < board.height; y++) {
+        for (int x = 0; x < board.width; x++) {
+            unsigned char cell = cells[y * board.width + x];
+            if (cell == CELL_EMPTY) continue;
+            Particle* p = board.AllocateParticle(Particle((float)x, (float)y, CellColor(cell)));
+            p->settled = (cell & CELL_SETTLED) != 0;
+            board.particles.push_back(p);
+        }
+    }
+    board.RebuildGrid();
+    board.MarkAllRowsDirty();
+    board.change_events.clear();
+    board.AddChangeEvent(BoardEventType::BOARD_RESET, 0, 0, board.width - 1, board.height - 1);
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "Board.hpp"
+#include <cstring>
+#include <vector>
+
+/**
+ * Kompaktní kódování obsahu desky po buňkách.
+ *
+ * Každá buňka se vejde do 4 bitů:
+ * - bity 0-2: index barvy v ALL_COLORS + 1 (0 = prázdná buňka)
+ * - bit 3: částice je usazená
+ *
+ * Řádky se ukládají jako RLE běhy po jednom bajtu: horní nibble je kód
+ * buňky, dolní nibble délka běhu - 1 (1-16 buněk). Plný řádek jedné barvy
+ * tak zabere jen pár bajtů. Formát sdílí uložené hry, záznamy i přetáčení.
+ */
+
+constexpr unsigned char CELL_EMPTY = 0x00;       // Prázdná buňka
+constexpr unsigned char CELL_COLOR_MASK = 0x07;  // Maska indexu barvy (+ 1)
+constexpr unsigned char CELL_SETTLED = 0x08;     // Příznak usazené částice
+
+/**
+ * Připojí hodnotu na konec bufferu v nativním (little endian) pořadí bajtů.
+ * @param out Výstupní buffer
+ * @param value Zapisovaná hodnota
+ */
+template <typename T>
+inline void AppendValue(std::vector<unsigned char>& out, T value) {
+    unsigned char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+/**
+ * Zakóduje částici do 4bitového kódu buňky.
+ * @param p Částice
+ * @return Kód buňky (nikdy CELL_EMPTY)
+ */
+unsigned char EncodeCell(const Particle& p);
+
+/**
+ * Vrátí barvu odpovídající kódu buňky.
+ * @param cell Kód buňky (nesmí být prázdná)
+ * @return Barva z palety ALL_COLORS
+ */
+Color CellColor(unsigned char cell);
+
+/**
+ * Zachytí obsah desky do pole kódů buněk (řádek po řádku).
+ * Čte přímo seznam částic, takže nezáleží na stavu mříže.
+ * @param board Zdrojová deska
+ * @param cells Výstupní pole, velikost se nastaví na width * height
+ */
+void CaptureCells(const Board& board, std::vector<unsigned char>& cells);
+
+/**
+ * Zachytí jeden řádek desky z prostorové mříže (mříž musí být aktuální).
+ * @param board Zdrojová deska
+ * @param y Index řádku
+ * @param row Výstupní kódy buněk (width buněk)
+ */
+void CaptureGridRow(const Board& board, int y, unsigned char* row);
+
+/**
+ * Zakóduje jeden řádek buněk pomocí RLE a připojí ho na konec výstupu.
+ * @param row Kódy buněk řádku
+ * @param width Počet buněk v řádku
+ * @param out Výstupní buffer
+ */
+void EncodeRowRLE(const unsigned char* row, int width, std::vector<unsigned char>& out);
+
+/**
+ * Dekóduje jeden RLE řádek.
+ * @param data Začátek zakódovaných dat
+ * @param end Konec dostupných dat
+ * @param row Výstupní řádek (width buněk)
+ * @param width Počet buněk v řádku
+ * @return Ukazatel za přečtená data, nebo nullptr při poškozených datech
+ */
+const unsigned char* DecodeRowRLE(const unsigned char* data, const unsigned char* end, unsigned char* row, int width);
+
+/**
+ * Nahradí všechny částice desky obsahem pole kódů buněk.
+ * Nastaví barvu a příznak usazení, rychlost je nulová. Případný
+ * rozpracovaný výbuch se zruší.
+ * @param board Cílová deska (musí mít stejné rozměry jako data)
+ * @param cells Kódy buněk (width * height)
+ */
+void RestoreBoardFromCells(Board& board, const unsigned char* cells);
@@ -0,0 +1,102 @@
+#include "InputSystem.hpp"
+#include <algorithm>
+#include <cmath>
+
+InputSystem::InputSystem() : actions(), gamepad(-1), keys(KeyboardKeys::ARROWS), tick_time(0.0), previous_tick_time(0.0) {}
+
+bool InputSystem::ReadAction(InputAction action) const {
+    bool pad = gamepad >= 0;
+    bool wasd = keys == KeyboardKeys::WASD;
+    switch (action) {
+        case InputAction::MOVE_LEFT:
+            return IsKeyDown(wasd ? KEY_A : KEY_LEFT) ||
+                   (pad && (IsGamepadButtonDown(gamepad, GAMEPAD_BUTTON_LEFT_FACE_LEFT) ||
+                            GetGamepadAxisMovement(gamepad, GAMEPAD_AXIS_LEFT_X) < -0.5f));
+        case InputAction::MOVE_RIGHT:
+            return IsKeyDown(wasd ? KEY_D : KEY_RIGHT) ||
+                   (pad && (IsGamepadButtonDown(gamepad, GAMEPAD_BUTTON_LEFT_FACE_RIGHT) ||
+                            GetGamepadAxisMovement(gamepad, GAMEPAD_AXIS_LEFT_X) > 0.5f));
+        case InputAction::SOFT_DROP:
+            return IsKeyDown(wasd ? KEY_S : KEY_DOWN) ||
+                   (pad && (IsGamepadButtonDown(gamepad, GAMEPAD_BUTTON_RIGHT_FACE_DOWN) ||   // A button
+                            IsGamepadButtonDown(gamepad, GAMEPAD_BUTTON_LEFT_FACE_DOWN)));
+        case InputAction::ROTATE:
+            return IsKeyDown(wasd ? KEY_W : KEY_UP) ||
+                   (pad && (IsGamepadButtonDown(gamepad, GAMEPAD_BUTTON_RIGHT_FACE_RIGHT) ||  // B button
+                            IsGamepadButtonDown(gamepad, GAMEPAD_BUTTON_LEFT_FACE_UP)));
+        case InputAction::MENU_UP:
+            return IsKeyDown(KEY_UP) ||
+                   (pad && (IsGamepadButtonDown(gamepad, GAMEPAD_BUTTON_LEFT_FACE_UP) ||
+                            GetGamepadAxisMovement(gamepad, GAMEPAD_AXIS_LEFT_Y) < -0.5f));
+        case InputAction::MENU_DOWN:
+            return IsKeyDown(KEY_DOWN) ||
+                   (pad && (IsGamepadButtonDown(gamepad, GAMEPAD_BUTTON_LEFT_FACE_DOWN) ||
+                            GetGamepadAxisMovement(gamepad, GAMEPAD_AXIS_LEFT_Y) > 0.5f));
+        case InputAction::CONFIRM:
+            return IsKeyDown(KEY_ENTER) ||
+                   (pad && IsGamepadButtonDown(gamepad, GAMEPAD_BUTTON_RIGHT_FACE_DOWN));     // A button
+        case InputAction::BACK:
+            return IsKeyDown(KEY_ESCAPE) ||
+                   (pad && IsGamepadButtonDown(gamepad, GAMEPAD_BUTTON_RIGHT_FACE_RIGHT));    // B button
+        case InputAction::PAUSE:
+            return IsKeyDown(KEY_ESCAPE) ||
+                   (pad && IsGamepadButtonDown(gamepad, GAMEPAD_BUTTON_MIDDLE_RIGHT));        // START button
+        case InputAction::SKIP:
+            return IsKeyDown(KEY_ENTER) || IsKeyDown(KEY_SPACE) || IsKeyDown(KEY_ESCAPE) ||
+                   (pad && IsGamepadButtonDown(gamepad, GAMEPAD_BUTTON_RIGHT_FACE_DOWN));     // A button
+        case InputAction::REWIND:
+            return IsKeyDown(KEY_R) ||
+                   (pad && IsGamepadButtonDown(gamepad, GAMEPAD_BUTTON_LEFT_TRIGGER_1));      // LB
+        default:
+            return false;
+    }
+}
+
+void InputSystem::Sample(double now) {
+    for (int i = 0; i < (int)InputAction::COUNT; i++) {
+        ActionState& action = actions[i];
+        bool down = ReadAction((InputAction)i);
+        // Hrana stisku - zapamatovat okamžik, opakování se od něj odpočítává
+        if (down && !action.down) {
+            action.pending_presses++;
+            action.press_time = now;
+            action.next_repeat_time = -1.0;
+        }
+        action.down = down;
+    }
+}
+
+void InputSystem::BeginTick(double now) {
+    Sample(now);
+    previous_tick_time = tick_time;
+    tick_time = now;
+    for (ActionState& action : actions) {
+        action.tick_presses = action.pending_presses;
+        action.pending_presses = 0;
+    }
+}
+
+int InputSystem::GetRepeatSteps(InputAction action, int das_ms, int arr_ms, int max_steps) {
+    ActionState& state = actions[(int)action];
+    int steps = std::min(state.tick_presses, max_steps);
+    if (!state.down) return steps;
+
+    if (state.next_repeat_time < 0.0) {
+        state.next_repeat_time = state.press_time + das_ms / 1000.0;
+    }
+    if (state.next_repeat_time > tick_time) return steps;
+
+    // Nulový interval - posun až na doraz
+    if (arr_ms <= 0) return max_steps;
+
+    double interval = arr_ms / 1000.0;
+    // Opakování z ticků, kdy se akce nevyzvedla, se přeskočí
+    if (state.next_repeat_time <= previous_tick_time) {
+        state.next_repeat_time += std::ceil((previous_tick_time - state.next_repeat_time) / interval + 1e-9) * interval;
+    }
+    while (state.next_repeat_time <= tick_time) {
+        if (steps < max_steps) steps++;
+        state.next_repeat_time += interval;
+    }
+    return steps;
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "raylib.h"
+
+/**
+ * Herní akce - každá sdružuje klávesy a tlačítka gamepadu, která ji spouští.
+ */
+enum class InputAction {
+    MOVE_LEFT,      // Posun kostky doleva (šipka, D-pad, páčka)
+    MOVE_RIGHT,     // Posun kostky doprava
+    SOFT_DROP,      // Rychlý pád (šipka dolů, A, D-pad dolů)
+    ROTATE,         // Rotace (šipka nahoru, B, D-pad nahoru)
+    MENU_UP,        // Pohyb v menu nahoru (šipka, D-pad, páčka)
+    MENU_DOWN,      // Pohyb v menu dolů
+    CONFIRM,        // Potvrzení v menu (Enter, A)
+    BACK,           // Zpět v menu (ESC, B)
+    PAUSE,          // Pauza během hry (ESC, START)
+    SKIP,           // Přeskočení úvodu (Enter, mezerník, ESC, A)
+    REWIND,         // Přetáčení v tréninku (R, LB)
+    COUNT
+};
+
+/**
+ * Klávesy pro ovládání kostky - v souboji má každý hráč půlku klávesnice.
+ */
+enum class KeyboardKeys {
+    ARROWS,         // Šipky (jeden hráč, pravý hráč souboje)
+    WASD            // W/A/S/D (levý hráč souboje)
+};
+
+/**
+ * Ovládání kostky hráčem za jeden tick (z hlavního vlákna do simulace).
+ */
+struct TickInput {
+    bool rewind;                     // Drží přetáčení (trénink)
+    int rotations;                   // Počet rotací
+    int move_steps;                  // Kroky posunu (záporné = doleva)
+    bool soft_drop;                  // Rychlý pád
+    int player;                      // Hráč souboje (0 mimo souboj)
+};
+
+/**
+ * Vstupní vrstva nezávislá na snímkové frekvenci.
+ *
+ * Stav vstupů se vzorkuje častěji než jednou za tick (Sample volá herní
+ * smyčka i během čekání na další tick) a každý stisk dostane časové
+ * razítko. Na začátku ticku BeginTick převezme stisky nasbírané od minula -
+ * i krátký ťuk mezi dvěma ticky se tak neztratí. Automatické opakování
+ * (DAS - prodleva před opakováním, ARR - interval opakování) se počítá
+ * v milisekundách od skutečného okamžiku stisku, takže ovládání je stejné
+ * při libovolné snímkové frekvenci a v jednom ticku může padnout i víc
+ * kroků opakování.
+ */
+class InputSystem {
+public:
+    /**
+     * Konstruktor - žádná akce není stisknutá.
+     */
+    InputSystem();
+
+    /**
+     * Nastaví gamepad, jehož tlačítka se čtou.
+     * @param gamepad ID gamepadu (-1 = jen klávesnice)
+     */
+    void SetGamepad(int gamepad) { this->gamepad = gamepad; }
+
+    /**
+     * Nastaví klávesy pro ovládání kostky (menu se ovládá vždy šipkami).
+     * @param keys Šipky nebo WASD
+     */
+    void SetKeyboardKeys(KeyboardKeys keys) { this->keys = keys; }
+
+    /**
+     * Přečte aktuální stav vstupů a zaznamená hrany stisku (po PollInputEvents).
+     * @param now Čas vzorku v sekundách (GetTime)
+     */
+    void Sample(double now);
+
+    /**
+     * Naposledy navzorkuje vstupy a převezme stisky pro nový tick.
+     * Stisky, které si předchozí tick nevyzvedl, zahodí.
+     * @param now Čas začátku ticku v sekundách (GetTime)
+     */
+    void BeginTick(double now);
+
+    /**
+     * @return true pokud je akce právě držená
+     */
+    bool IsDown(InputAction action) const { return actions[(int)action].down; }
+
+    /**
+     * @return true pokud byla akce od minulého ticku stisknuta
+     */
+    bool IsPressed(InputAction action) const { return actions[(int)action].tick_presses > 0; }
+
+    /**
+     * Počet kroků akce s automatickým opakováním v tomto ticku: každý stisk
+     * je jeden krok, při držení přibude krok po DAS a pak každých ARR ms.
+     * Volá se nejvýš jednou za tick; opakování z ticků, kdy se akce
+     * nevyzvedla (např. čekání na novou kostku), se nedohání.
+     * @param action Akce
+     * @param das_ms Prodleva před prvním opakováním v milisekundách
+     * @param arr_ms Interval opakování v milisekundách (0 = okamžitě max_steps)
+     * @param max_steps Nejvyšší počet kroků za tick
+     * @return Počet kroků k provedení
+     */
+    int GetRepeatSteps(InputAction action, int das_ms, int arr_ms, int max_steps);
+
+private:
+    /**
+     * Stav jedné akce.
+     */
+    struct ActionState {
+        bool down;                  // Právě držená
+        int pending_presses;        // Stisky od posledního BeginTick
+        int tick_presses;           // Stisky převzaté aktuálním tickem
+        double press_time;          // Okamžik posledního stisku
+        double next_repeat_time;    // Okamžik dalšího kroku opakování (< 0 = neplánováno)
+    };
+
+    ActionState actions[(int)InputAction::COUNT];
+    int gamepad;                    // Čtený gamepad (-1 = žádný)
+    KeyboardKeys keys;              // Klávesy pro ovládání kostky
+    double tick_time;               // Začátek aktuálního ticku
+    double previous_tick_time;      // Začátek předchozího ticku
+
+    /**
+     * @return true pokud je některý vstup akce držený
+     */
+    bool ReadAction(InputAction action) const;
+};
@@ -3,169 +3,155 @@
 // Global instance
 Localization localization;
 
-Localization::Localization() : current_language(Language::ENGLISH) {
-    InitializeTexts();
-}
+namespace {
+// Překlady - jeden blok na jazyk v pořadí Language, uvnitř v pořadí TextKey.
+// Přidání jazyka = nová hodnota v Language, nový blok zde a jméno v LANGUAGE_NAMES.
+constexpr std::string_view TEXTS[(int)Language::COUNT][(int)TextKey::COUNT] = {
+    // ENGLISH
+    {
+        // Main Menu
+        "Continue",                                 // MAIN_MENU_CONTINUE
+        "New Game",                                 // MAIN_MENU_NEW_GAME
+        "Practice",                                 // MAIN_MENU_PRACTICE
+        "Autoplay",                                 // MAIN_MENU_AUTOPLAY
+        "Versus",                                   // MAIN_MENU_VERSUS
+        "Settings",                                 // MAIN_MENU_SETTINGS
+        "Exit",                                     // MAIN_MENU_EXIT
 
-void Localization::InitializeTexts() {
-    // Main Menu
-    texts[TextKey::MAIN_MENU_NEW_GAME] = {
-        {Language::ENGLISH, "New Game"},
-        {Language::CZECH, "Nová hra"}
-    };
-    texts[TextKey::MAIN_MENU_SETTINGS] = {
-        {Language::ENGLISH, "Settings"},
-        {Language::CZECH, "Nastavení"}
-    };
-    texts[TextKey::MAIN_MENU_EXIT] = {
-        {Language::ENGLISH, "Exit"},
-        {Language::CZECH, "Konec"}
-    };
-
-    // Settings Menu
-    texts[TextKey::SETTINGS_TITLE] = {
-        {Language::ENGLISH, "SETTINGS"},
-        {Language::CZECH, "NASTAVENÍ"}
-    };
-    texts[TextKey::SETTINGS_DIFFICULTY_INFO] = {
-        {Language::ENGLISH, "Difficulty determines number of colors:"},
-        {Language::CZECH, "Obtížnost určuje počet barev:"}
-    };
-    texts[TextKey::SETTINGS_EASY] = {
-        {Language::ENGLISH, "Easy (3 colors)"},
-        {Language::CZECH, "Lehká (3 barvy)"}
-    };
-    texts[TextKey::SETTINGS_NORMAL] = {
-        {Language::ENGLISH, "Normal (4 colors)"},
-        {Language::CZECH, "Normální (4 barvy)"}
-    };
-    texts[TextKey::SETTINGS_HARD] = {
-        {Language::ENGLISH, "Hard (6 colors)"},
-        {Language::CZECH, "Těžká (6 barev)"}
-    };
-    texts[TextKey::SETTINGS_MUSIC] = {
-        {Language::ENGLISH, "Music"},
-        {Language::CZECH, "Hudba"}
-    };
-    texts[TextKey::SETTINGS_FPS] = {
-        {Language::ENGLISH, "FPS"},
-        {Language::CZECH, "FPS"}
-    };
-    texts[TextKey::SETTINGS_GAMEPAD] = {
-        {Language::ENGLISH, "Gamepad"},
-        {Language::CZECH, "Gamepad"}
-    };
-    texts[TextKey::SETTINGS_LANGUAGE] = {
-        {Language::ENGLISH, "Language"},
-        {Language::CZECH, "Jazyk"}
-    };
-    texts[TextKey::SETTINGS_BACK] = {
-        {Language::ENGLISH, "ESC = Back"},
-        {Language::CZECH, "ESC = Zpět"}
-    };
-    texts[TextKey::SETTINGS_ON] = {
-        {Language::ENGLISH, "ON"},
-        {Language::CZECH, "ZAPNUTO"}
-    };
-    texts[TextKey::SETTINGS_OFF] = {
-        {Language::ENGLISH, "OFF"},
-        {Language::CZECH, "VYPNUTO"}
-    };
-    texts[TextKey::SETTINGS_GAMEPAD_CONNECTED] = {
-        {Language::ENGLISH, "Connected"},
-        {Language::CZECH, "Připojen"}
-    };
-    texts[TextKey::SETTINGS_GAMEPAD_NOT_CONNECTED] = {
-        {Language::ENGLISH, "Not connected"},
-        {Language::CZECH, "Není připojen"}
-    };
-
-    // Pause Menu
-    texts[TextKey::PAUSE_TITLE] = {
-        {Language::ENGLISH, "PAUSED"},
-        {Language::CZECH, "PAUZA"}
-    };
-    texts[TextKey::PAUSE_RESUME] = {
-        {Language::ENGLISH, "Resume"},
-        {Language::CZECH, "Pokračovat"}
-    };
-    texts[TextKey::PAUSE_MAIN_MENU] = {
-        {Language::ENGLISH, "Main Menu"},
-        {Language::CZECH, "Hlavní menu"}
-    };
-    texts[TextKey::PAUSE_EXIT] = {
-        {Language::ENGLISH, "Exit"},
-        {Language::CZECH, "Konec"}
-    };
-
-    // Game UI
-    texts[TextKey::GAME_SCORE] = {
-        {Language::ENGLISH, "SCORE"},
-        {Language::CZECH, "SKÓRE"}
-    };
-    texts[TextKey::GAME_NEXT_PIECE] = {
-        {Language::ENGLISH, "NEXT PIECE"},
-        {Language::CZECH, "DALŠÍ KOSTKA"}
-    };
-    texts[TextKey::GAME_DIFFICULTY] = {
-        {Language::ENGLISH, "DIFFICULTY"},
-        {Language::CZECH, "OBTÍŽNOST"}
-    };
-    texts[TextKey::GAME_OVER_TITLE] = {
-        {Language::ENGLISH, "GAME OVER"},
-        {Language::CZECH, "GAME OVER"}
-    };
-    texts[TextKey::GAME_OVER_SCORE] = {
-        {Language::ENGLISH, "Score"},
-        {Language::CZECH, "Skóre"}
-    };
-    texts[TextKey::GAME_OVER_ESC] = {
-        {Language::ENGLISH, "ESC = Menu"},
-        {Language::CZECH, "ESC = Menu"}
-    };
-
-    // Difficulty Levels
-    texts[TextKey::DIFFICULTY_EASY] = {
-        {Language::ENGLISH, "Easy"},
-        {Language::CZECH, "Lehká"}
-    };
-    texts[TextKey::DIFFICULTY_NORMAL] = {
-        {Language::ENGLISH, "Normal"},
-        {Language::CZECH, "Normální"}
-    };
-    texts[TextKey::DIFFICULTY_HARD] = {
-        {Language::ENGLISH, "Hard"},
-        {Language::CZECH, "Těžká"}
-    };
-
-    // FPS Counter
-    texts[TextKey::FPS_COUNTER] = {
-        {Language::ENGLISH, "FPS"},
-        {Language::CZECH, "FPS"}
-    };
-}
+        // Settings Menu
+        "SETTINGS",                                 // SETTINGS_TITLE
+        "Difficulty determines number of colors:",  // SETTINGS_DIFFICULTY_INFO
+        "Easy (3 colors)",                          // SETTINGS_EASY
+        "Normal (4 colors)",                        // SETTINGS_NORMAL
+        "Hard (6 colors)",                          // SETTINGS_HARD
+        "Music",                                    // SETTINGS_MUSIC
+        "Sound effects",                            // SETTINGS_SFX
+        "FPS",                                      // SETTINGS_FPS
+        "Gamepad",                                  // SETTINGS_GAMEPAD
+        "Language",                                 // SETTINGS_LANGUAGE
+        "ESC = Back",                               // SETTINGS_BACK
+        "ON",                                       // SETTINGS_ON
+        "OFF",                                      // SETTINGS_OFF
+        "Connected",                                // SETTINGS_GAMEPAD_CONNECTED
+        "Not connected",                            // SETTINGS_GAMEPAD_NOT_CONNECTED
+
+        // Pause Menu
+        "PAUSED",                                   // PAUSE_TITLE
+        "Resume",                                   // PAUSE_RESUME
+        "Main Menu",                                // PAUSE_MAIN_MENU
+        "Exit",                                     // PAUSE_EXIT
+
+        // Game UI
+        "SCORE",                                    // GAME_SCORE
+        "NEXT PIECE",                               // GAME_NEXT_PIECE
+        "DIFFICULTY",                               // GAME_DIFFICULTY
+        "Hold R = Rewind",                          // GAME_REWIND_HINT
+        "Waiting for stream...",                    // GAME_SPECTATOR_WAITING
+        "GAME OVER",                                // GAME_OVER_TITLE
+        "Score",                                    // GAME_OVER_SCORE
+        "ESC = Menu",                               // GAME_OVER_ESC
+        "PLAYER",                                   // GAME_VERSUS_PLAYER
+        "WINS!",                                    // GAME_VERSUS_WINS
+        "DRAW",                                     // GAME_VERSUS_DRAW
+
+        // Difficulty Levels
+        "Easy",                                     // DIFFICULTY_EASY
+        "Normal",                                   // DIFFICULTY_NORMAL
+        "Hard",                                     // DIFFICULTY_HARD
+
+        // FPS Counter
+        "FPS",                                      // FPS_COUNTER
+    },
+    // CZECH
+    {
+        // Main Menu
+        "Pokračovat",                               // MAIN_MENU_CONTINUE
+        "Nová hra",                                 // MAIN_MENU_NEW_GAME
+        "Trénink",                                  // MAIN_MENU_PRACTICE
+        "Automatická hra",                          // MAIN_MENU_AUTOPLAY
+        "Souboj",                                   // MAIN_MENU_VERSUS
+        "Nastavení",                                // MAIN_MENU_SETTINGS
+        "Konec",                                    // MAIN_MENU_EXIT
+
+        // Settings Menu
+        "NASTAVENÍ",                                // SETTINGS_TITLE
+        "Obtížnost určuje počet barev:",            // SETTINGS_DIFFICULTY_INFO
+        "Lehká (3 barvy)",                          // SETTINGS_EASY
+        "Normální (4 barvy)",                       // SETTINGS_NORMAL
+        "Těžká (6 barev)",                          // SETTINGS_HARD
+        "Hudba",                                    // SETTINGS_MUSIC
+        "Zvukové efekty",                           // SETTINGS_SFX
+        "FPS",                                      // SETTINGS_FPS
+        "Gamepad",                                  // SETTINGS_GAMEPAD
+        "Jazyk",                                    // SETTINGS_LANGUAGE
+        "ESC = Zpět",                               // SETTINGS_BACK
+        "ZAPNUTO",                                  // SETTINGS_ON
+        "VYPNUTO",                                  // SETTINGS_OFF
+        "Připojen",                                 // SETTINGS_GAMEPAD_CONNECTED
+        "Není připojen",                            // SETTINGS_GAMEPAD_NOT_CONNECTED
+
+        // Pause Menu
+        "PAUZA",                                    // PAUSE_TITLE
+        "Pokračovat",                               // PAUSE_RESUME
+        "Hlavní menu",                              // PAUSE_MAIN_MENU
+        "Konec",                                    // PAUSE_EXIT
+
+        // Game UI
+        "SKÓRE",                                    // GAME_SCORE
+        "DALŠÍ KOSTKA",                             // GAME_NEXT_PIECE
+        "OBTÍŽNOST",                                // GAME_DIFFICULTY
+        "Drž R = Přetočit",                         // GAME_REWIND_HINT
+        "Čekám na přenos...",                       // GAME_SPECTATOR_WAITING
+        "GAME OVER",                                // GAME_OVER_TITLE
+        "Skóre",                                    // GAME_OVER_SCORE
+        "ESC = Menu",                               // GAME_OVER_ESC
+        "HRÁČ",                                     // GAME_VERSUS_PLAYER
+        "VYHRÁVÁ!",                                 // GAME_VERSUS_WINS
+        "REMÍZA",                                   // GAME_VERSUS_DRAW
 
-const char* Localization::GetText(TextKey key) const {
-    auto it = texts.find(key);
-    if (it != texts.end()) {
-        auto lang_it = it->second.find(current_language);
-        if (lang_it != it->second.end()) {
-            return lang_it->second.c_str();
+        // Difficulty Levels
+        "Lehká",                                    // DIFFICULTY_EASY
+        "Normální",                                 // DIFFICULTY_NORMAL
+        "Těžká",                                    // DIFFICULTY_HARD
+
+        // FPS Counter
+        "FPS",                                      // FPS_COUNTER
+    }
+};
+
+constexpr std::string_view LANGUAGE_NAMES[(int)Language::COUNT] = {
+    "English",
+    "Čeština"
+};
+
+// Chybějící překlad (kratší blok jazyka) se odhalí už při překladu
+constexpr bool AllTextsPresent() {
+    for (int lang = 0; lang < (int)Language::COUNT; lang++) {
+        if (LANGUAGE_NAMES[lang].empty()) return false;
+        for (int key = 0; key < (int)TextKey::COUNT; key++) {
+            if (TEXTS[lang][key].empty()) return false;
         }
     }
-    return "[Missing Translation]";
+    return true;
+}
+static_assert(AllTextsPresent(), "Every language needs a translation for every TextKey");
 }
 
+Localization::Localization() : current_language(Language::ENGLISH), current_texts(TEXTS[0]), revision(0) {}
+
 void Localization::SetLanguage(Language lang) {
+    if (lang == current_language) return;
     current_language = lang;
+    current_texts = TEXTS[(int)lang];
+    revision++;
+}
+
+Language Localization::GetNextLanguage() const {
+    return (Language)(((int)current_language + 1) % (int)Language::COUNT);
 }
 
 const char* Localization::GetLanguageName(Language lang) const {
-    switch (lang) {
-        case Language::ENGLISH: return "English";
-        case Language::CZECH: return "Čeština";
-        default: return "Unknown";
-    }
+    return LANGUAGE_NAMES[(int)lang].data();
 }
 
 const char* Localization::GetCurrentLanguageName() const {
@@ -1,18 +1,23 @@
 #ifndef LOCALIZATION_HPP
 #define LOCALIZATION_HPP
 
-#include <string>
-#include <map>
+#include <string_view>
 
 enum class Language {
     ENGLISH,
-    CZECH
+    CZECH,
+
+    COUNT   // Počet jazyků (musí být poslední)
 };
 
 // Text keys used throughout the game
 enum class TextKey {
     // Main Menu
+    MAIN_MENU_CONTINUE,
     MAIN_MENU_NEW_GAME,
+    MAIN_MENU_PRACTICE,
+    MAIN_MENU_AUTOPLAY,
+    MAIN_MENU_VERSUS,
     MAIN_MENU_SETTINGS,
     MAIN_MENU_EXIT,
 
@@ -23,6 +28,7 @@ enum class TextKey {
     SETTINGS_NORMAL,
     SETTINGS_HARD,
     SETTINGS_MUSIC,
+    SETTINGS_SFX,
     SETTINGS_FPS,
     SETTINGS_GAMEPAD,
     SETTINGS_LANGUAGE,
@@ -42,9 +48,14 @@ enum class TextKey {
     GAME_SCORE,
     GAME_NEXT_PIECE,
     GAME_DIFFICULTY,
+    GAME_REWIND_HINT,
+    GAME_SPECTATOR_WAITING,
     GAME_OVER_TITLE,
     GAME_OVER_SCORE,
     GAME_OVER_ESC,
+    GAME_VERSUS_PLAYER,
+    GAME_VERSUS_WINS,
+    GAME_VERSUS_DRAW,
 
     // Difficulty Levels
     DIFFICULTY_EASY,
@@ -52,26 +63,34 @@ enum class TextKey {
     DIFFICULTY_HARD,
 
     // FPS Counter
-    FPS_COUNTER
+    FPS_COUNTER,
+
+    COUNT   // Počet textů (musí být poslední)
 };
 
+// Translations live in a dense compile-time [Language][TextKey] table of string literals
 class Localization {
 private:
     Language current_language;
-    std::map<TextKey, std::map<Language, std::string>> texts;
-
-    void InitializeTexts();
+    const std::string_view* current_texts;   // Row of the table for current language
+    unsigned int revision;                   // Incremented on every language change
 
 public:
     Localization();
 
-    // Get translated text for current language
-    const char* GetText(TextKey key) const;
+    // Get translated text for current language (a single array index)
+    const char* GetText(TextKey key) const { return current_texts[(int)key].data(); }
 
     // Change language
     void SetLanguage(Language lang);
     Language GetLanguage() const { return current_language; }
 
+    // Language following the current one (cycling in settings)
+    Language GetNextLanguage() const;
+
+    // Changes whenever texts change - lets callers cache formatted strings
+    unsigned int GetRevision() const { return revision; }
+
     // Helper to get language name for display
     const char* GetLanguageName(Language lang) const;
     const char* GetCurrentLanguageName() const;
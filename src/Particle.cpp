@@ -1,13 +1,14 @@
 #include "Particle.hpp"
 #include "Constants.hpp"
 #include "Utils.hpp"
+#include "GrainAtlas.hpp"
 
 // Konstruktor - vytvoří základní částici
 Particle::Particle(float x, float y, Color color)
     : x(x), y(y), color(color), velocity_y(0), settled(false), brightness(1.0f) {}
 
 // Vykreslí částici s možnými efekty (enhanced mode pro padající tetromino, scale pro výbuchy)
-void Particle::Draw(int offset_x, int offset_y, bool enhanced, float scale) {
+void Particle::Draw(int offset_x, int offset_y, bool enhanced, float scale) const {
     // Vypočítat pixel pozici
     int base_x = offset_x + (int)x * PARTICLE_SIZE;
     int base_y = offset_y + (int)y * PARTICLE_SIZE;
@@ -19,20 +20,26 @@ void Particle::Draw(int offset_x, int offset_y, bool enhanced, float scale) {
     int y_pos = base_y + size_diff / 2;
 
     if (enhanced) {
-        // Enhanced rendering pro aktivní tetromino
-        Color inner = BrightenColor(color, 1.2f + (scale - 1.0f) * 0.5f);
-        DrawRectangle(x_pos, y_pos, scaled_size, scaled_size, inner);
-        Color bright = BrightenColor(color, 1.4f + (scale - 1.0f) * 0.8f);
-        DrawRectangleLines(x_pos, y_pos, scaled_size, scaled_size, bright);
+        // Enhanced rendering pro aktivní tetromino (dlaždice atlasu, mimo paletu postaru)
+        if (!grain_atlas.DrawGrain(color, GrainAtlas::EnhancedColumn(scale), (float)x_pos, (float)y_pos, (float)scaled_size)) {
+            Color inner = BrightenColor(color, 1.2f + (scale - 1.0f) * 0.5f);
+            DrawRectangle(x_pos, y_pos, scaled_size, scaled_size, inner);
+            Color bright = BrightenColor(color, 1.4f + (scale - 1.0f) * 0.8f);
+            DrawRectangleLines(x_pos, y_pos, scaled_size, scaled_size, bright);
+        }
 
         // Glow efekt pro velké škálování (při výbuchu)
         if (scale > 1.2f) {
-            Color glow = color;
-            glow.a = (unsigned char)(80 * (scale - 1.0f));
-            DrawRectangle(x_pos - 2, y_pos - 2, scaled_size + 4, scaled_size + 4, glow);
+            unsigned char glow_alpha = (unsigned char)(80 * (scale - 1.0f));
+            if (!grain_atlas.DrawGrain(color, GrainAtlas::GLOW, (float)(x_pos - 2), (float)(y_pos - 2),
+                                       (float)(scaled_size + 4), Color{255, 255, 255, glow_alpha})) {
+                DrawRectangle(x_pos - 2, y_pos - 2, scaled_size + 4, scaled_size + 4, ColorWithAlpha(color, glow_alpha));
+            }
         }
     } else {
-        // Normální rendering pro částice na desce
+        // Normální rendering pro částice na desce - jedna dlaždice atlasu
+        if (grain_atlas.DrawGrain(color, GrainAtlas::NORMAL, (float)x_pos, (float)y_pos, (float)scaled_size)) return;
+
         DrawRectangle(x_pos, y_pos, scaled_size, scaled_size, color);
 
         // Highlight (světlá linie nahoře a vlevo)
@@ -31,5 +31,5 @@ public:
      * @param enhanced Pokud true, vykreslí s vylepšeným vizuálním efektem
      * @param scale Škálovací faktor velikosti (1.0 = normální)
      */
-    void Draw(int offset_x, int offset_y, bool enhanced = false, float scale = 1.0f);
+    void Draw(int offset_x, int offset_y, bool enhanced = false, float scale = 1.0f) const;
 };
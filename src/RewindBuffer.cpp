@@ -0,0 +1,118 @@
+#include "RewindBuffer.hpp"
+#include "GridCodec.hpp"
+#include <algorithm>
+
+namespace {
+constexpr unsigned short ROW_END = 0xFFFF;  // Konec seznamu řádků v záznamu ticku
+}
+
+RewindBuffer::RewindBuffer(int width, int height, int max_ticks, size_t capacity_bytes)
+    : width(width), height(height), first_tick(0), tick_count(0), write_offset(0), last_state{} {
+    shadow.assign(width * height, CELL_EMPTY);
+    row_buffer.resize(width);
+    storage.resize(capacity_bytes);
+    ticks.resize(std::max(1, max_ticks));
+    // Nejhorší případ ticku: všechny řádky bez komprese
+    scratch.reserve(sizeof(RewindState) + height * (sizeof(unsigned short) + width) + sizeof(ROW_END));
+}
+
+void RewindBuffer::Reset(Board& board, const RewindState& state) {
+    CaptureCells(board, shadow);
+    seen_versions = board.row_versions;
+    first_tick = 0;
+    tick_count = 0;
+    write_offset = 0;
+    last_state = state;
+}
+
+void RewindBuffer::Capture(Board& board, const RewindState& state) {
+    if (board.grid_dirty) board.RebuildGrid();
+
+    // Undo záznam: herní hodnoty předchozího ticku + původní obsah změněných řádků
+    scratch.clear();
+    AppendValue<RewindState>(scratch, last_state);
+    for (int y = 0; y < height; y++) {
+        if (board.row_versions[y] == seen_versions[y]) continue;
+        seen_versions[y] = board.row_versions[y];
+
+        CaptureGridRow(board, y, row_buffer.data());
+        unsigned char* old_row = &shadow[y * width];
+        if (std::equal(row_buffer.begin(), row_buffer.end(), old_row)) continue;
+
+        AppendValue<unsigned short>(scratch, (unsigned short)y);
+        EncodeRowRLE(old_row, width, scratch);
+        std::copy(row_buffer.begin(), row_buffer.end(), old_row);
+    }
+    AppendValue<unsigned short>(scratch, ROW_END);
+    last_state = state;
+
+    size_t size = scratch.size();
+    if (size > storage.size()) {
+        // Tick se do bufferu nevejde - historie by nebyla souvislá
+        tick_count = 0;
+        write_offset = 0;
+        return;
+    }
+
+    if (tick_count == (int)ticks.size()) DropOldest();
+    size_t offset = MakeRoom(size);
+
+    std::copy(scratch.begin(), scratch.end(), storage.begin() + offset);
+    ticks[(first_tick + tick_count) % ticks.size()] = {offset, size};
+    tick_count++;
+    write_offset = offset + size;
+}
+
+bool RewindBuffer::StepBack(RewindState& state) {
+    if (tick_count == 0) return false;
+
+    const TickRecord& record = ticks[(first_tick + tick_count - 1) % ticks.size()];
+    const unsigned char* cursor = &storage[record.offset];
+    const unsigned char* end = cursor + record.size;
+
+    std::memcpy(&state, cursor, sizeof(RewindState));
+    cursor += sizeof(RewindState);
+    for (;;) {
+        unsigned short y;
+        if (end - cursor < (int)sizeof(y)) break;
+        std::memcpy(&y, cursor, sizeof(y));
+        cursor += sizeof(y);
+        if (y == ROW_END || y >= height) break;
+        cursor = DecodeRowRLE(cursor, end, &shadow[y * width], width);
+        if (!cursor) break;
+    }
+
+    last_state = state;
+    tick_count--;
+    write_offset = record.offset;
+    return true;
+}
+
+void RewindBuffer::Restore(Board& board) {
+    RestoreBoardFromCells(board, shadow.data());
+    // Deska teď přesně odpovídá stínu
+    seen_versions = board.row_versions;
+}
+
+void RewindBuffer::DropOldest() {
+    first_tick = (first_tick + 1) % (int)ticks.size();
+    tick_count--;
+}
+
+size_t RewindBuffer::MakeRoom(size_t size) {
+    size_t offset = write_offset;
+    if (offset + size > storage.size()) {
+        // Přetočení na začátek - ticky za write_offset jsou nejstarší
+        // (z minulého průchodu) a zbytek konce bloku se už nevyužije
+        while (tick_count > 0 && ticks[first_tick].offset >= write_offset) DropOldest();
+        offset = 0;
+    }
+    // Ticky leží v bloku za sebou od nejstaršího, stačí hlídat ten
+    while (tick_count > 0 && Overlaps(offset, size)) DropOldest();
+    return offset;
+}
+
+bool RewindBuffer::Overlaps(size_t offset, size_t size) const {
+    const TickRecord& oldest = ticks[first_tick];
+    return offset < oldest.offset + oldest.size && oldest.offset < offset + size;
+}
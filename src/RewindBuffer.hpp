@@ -0,0 +1,106 @@
+#pragma once
+
+#include "Board.hpp"
+#include "Snapshot.hpp"
+#include <vector>
+
+/**
+ * Herní hodnoty mimo desku, které se při přetáčení obnovují spolu s ní.
+ */
+struct RewindState {
+    PieceSnapshot current;          // Padající tetromino
+    PieceSnapshot next;             // Náhled další kostky
+    int score;                      // Skóre
+    int fall_speed;                 // Rychlost pádu
+    int fall_counter;               // Počítadlo pádu
+    bool waiting_for_settlement;    // Čeká se na usazení před spawnem
+};
+
+/**
+ * Kruhový buffer pro přetáčení hry zpět (tréninkový režim).
+ *
+ * Udržuje stínovou kopii desky v kódech buněk (GridCodec.hpp). Každý tick
+ * projde jen řádky se změněnou verzí (Board::row_versions) a pro ty, které se opravdu
+ * změnily, uloží původní obsah řádku v RLE (undo záznam) spolu s herními
+ * hodnotami předchozího ticku. Záznamy leží v jednom předalokovaném bloku
+ * paměti - když dojde místo nebo počet ticků, nejstarší se zahodí.
+ */
+class RewindBuffer {
+public:
+    /**
+     * Konstruktor - předalokuje veškerou paměť.
+     * @param width Šířka desky v buňkách částic
+     * @param height Výška desky v buňkách částic
+     * @param max_ticks Maximální počet uchovaných ticků
+     * @param capacity_bytes Velikost bloku pro záznamy
+     */
+    RewindBuffer(int width, int height, int max_ticks = 600, size_t capacity_bytes = 4 * 1024 * 1024);
+
+    /**
+     * Zahodí historii a převezme aktuální stav desky jako výchozí.
+     * @param board Deska
+     * @param state Aktuální herní hodnoty
+     */
+    void Reset(Board& board, const RewindState& state);
+
+    /**
+     * Zaznamená změny od minulého ticku.
+     * @param board Deska
+     * @param state Aktuální herní hodnoty
+     */
+    void Capture(Board& board, const RewindState& state);
+
+    /**
+     * Vrátí stínovou desku o jeden tick zpět.
+     * @param state Výstup - herní hodnoty v cílovém ticku
+     * @return false pokud už není kam přetáčet
+     */
+    bool StepBack(RewindState& state);
+
+    /**
+     * Přenese stínový stav na desku (pokračování hry od přetočeného ticku).
+     * @param board Cílová deska
+     */
+    void Restore(Board& board);
+
+    /**
+     * @return Počet ticků, o které lze přetočit zpět
+     */
+    int GetTickCount() const { return tick_count; }
+
+private:
+    /**
+     * Umístění jednoho ticku v bloku záznamů.
+     */
+    struct TickRecord {
+        size_t offset, size;
+    };
+
+    int width, height;
+    std::vector<unsigned char> shadow;        // Stav desky v posledním zaznamenaném ticku
+    std::vector<unsigned int> seen_versions;  // Verze řádků desky odpovídající stínu
+    std::vector<unsigned char> row_buffer;    // Pracovní řádek
+    std::vector<unsigned char> storage;       // Blok záznamů (kruhový)
+    std::vector<unsigned char> scratch;       // Pracovní buffer pro kódování ticku
+    std::vector<TickRecord> ticks;            // Kruhový index ticků
+    int first_tick, tick_count;               // Nejstarší tick v indexu a jejich počet
+    size_t write_offset;                      // Kam se zapíše další záznam
+    RewindState last_state;                   // Herní hodnoty posledního zaznamenaného ticku
+
+    /**
+     * Zahodí nejstarší tick.
+     */
+    void DropOldest();
+
+    /**
+     * Najde místo pro další záznam a zahodí ticky, které by přepsal.
+     * @param size Velikost záznamu (nejvýš velikost bloku)
+     * @return Offset záznamu v bloku
+     */
+    size_t MakeRoom(size_t size);
+
+    /**
+     * Zjistí, zda zápis bloku [offset, offset + size) nepřepíše nejstarší tick.
+     */
+    bool Overlaps(size_t offset, size_t size) const;
+};
@@ -0,0 +1,177 @@
+#include "SfxMixer.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <random>
+
+namespace {
+constexpr int SAMPLE_RATE = 44100;
+constexpr int STREAM_BUFFER_FRAMES = 512;   // ~12 ms - efekt zazní do jednoho bufferu
+constexpr float PI_F = 3.14159265f;
+
+const char* const CLIP_NAMES[] = {"rotate", "lock", "landing", "charge", "explosion"};
+
+std::atomic<SfxMixer*> active_mixer(nullptr);
+}
+
+const char* SfxMixer::GetClipName(SfxId id) {
+    return CLIP_NAMES[(int)id];
+}
+
+// Syntéza efektů - vlastní generátor, aby se neposouval herní gen
+std::vector<float> SfxMixer::SynthesizeClip(SfxId id) {
+    std::mt19937 noise_gen(1234 + (int)id);
+    std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+    std::vector<float> out;
+    float phase = 0.0f;
+    float lowpass = 0.0f;
+
+    auto emit = [&](float seconds, auto sample) {
+        int count = (int)(seconds * SAMPLE_RATE);
+        for (int i = 0; i < count; i++) out.push_back(sample((float)i / count, (float)i / SAMPLE_RATE));
+    };
+
+    switch (id) {
+        case SfxId::ROTATE:
+            // Krátký stoupající tón
+            emit(0.06f, [&](float t, float) {
+                phase += 2.0f * PI_F * (900.0f + 400.0f * t) / SAMPLE_RATE;
+                return std::sin(phase) * std::exp(-5.0f * t) * 0.35f;
+            });
+            break;
+        case SfxId::LOCK:
+            // Klik a nízký tón
+            emit(0.09f, [&](float t, float time) {
+                phase += 2.0f * PI_F * 180.0f / SAMPLE_RATE;
+                float click = time < 0.004f ? noise(noise_gen) * 0.6f : 0.0f;
+                return click + std::sin(phase) * std::exp(-6.0f * t) * 0.5f;
+            });
+            break;
+        case SfxId::LANDING:
+            // Tlumený šum s hlubokým základem
+            emit(0.12f, [&](float t, float) {
+                phase += 2.0f * PI_F * 70.0f / SAMPLE_RATE;
+                lowpass += (noise(noise_gen) - lowpass) * 0.08f;
+                return (lowpass * 0.8f + std::sin(phase) * 0.5f) * std::exp(-8.0f * t);
+            });
+            break;
+        case SfxId::CHARGE:
+            // Stoupající tón s tremolem po dobu zoom animace (1 s)
+            emit(1.0f, [&](float t, float time) {
+                phase += 2.0f * PI_F * (200.0f + 700.0f * t * t) / SAMPLE_RATE;
+                float tremolo = 0.75f + 0.25f * std::sin(2.0f * PI_F * (6.0f + 18.0f * t) * time);
+                return std::sin(phase) * tremolo * (0.1f + 0.3f * t);
+            });
+            break;
+        case SfxId::EXPLOSION:
+            // Šumový výbuch s dunivým basem
+            emit(0.9f, [&](float t, float) {
+                phase += 2.0f * PI_F * (55.0f - 20.0f * t) / SAMPLE_RATE;
+                lowpass += (noise(noise_gen) - lowpass) * (0.5f - 0.4f * t);
+                return (lowpass * 0.7f + std::sin(phase) * 0.45f) * std::exp(-4.0f * t);
+            });
+            break;
+        case SfxId::COUNT:
+            break;
+    }
+    return out;
+}
+
+bool SfxMixer::DecodeClip(const unsigned char* data, int size, std::vector<float>& out) {
+    Wave wave = LoadWaveFromMemory(".wav", data, size);
+    if (!IsWaveValid(wave)) return false;
+    WaveFormat(&wave, SAMPLE_RATE, 32, 1);
+    const float* samples = (const float*)wave.data;
+    out.assign(samples, samples + wave.frameCount);
+    UnloadWave(wave);
+    return true;
+}
+
+SfxMixer::SfxMixer(const std::vector<float>* clip_pcm) : voices{}, voice_counter(0), stream{}, stream_ready(false) {
+    // Všechny efekty do jednoho bloku - pcm se po startu už nemění
+    size_t total = 0;
+    for (int i = 0; i < (int)SfxId::COUNT; i++) total += clip_pcm[i].size();
+    pcm.reserve(total);
+    for (int i = 0; i < (int)SfxId::COUNT; i++) {
+        clips[i] = {pcm.size(), clip_pcm[i].size()};
+        pcm.insert(pcm.end(), clip_pcm[i].begin(), clip_pcm[i].end());
+    }
+
+    // Malý buffer jen pro tento stream, ostatní streamy dostanou výchozí velikost
+    SetAudioStreamBufferSizeDefault(STREAM_BUFFER_FRAMES);
+    stream = LoadAudioStream(SAMPLE_RATE, 32, 1);
+    SetAudioStreamBufferSizeDefault(0);
+    if (!IsAudioStreamValid(stream)) {
+        TraceLog(LOG_WARNING, "SFX: Failed to create audio stream");
+        return;
+    }
+
+    active_mixer = this;
+    SetAudioStreamCallback(stream, &SfxMixer::AudioCallback);
+    PlayAudioStream(stream);
+    stream_ready = true;
+}
+
+SfxMixer::~SfxMixer() {
+    if (!stream_ready) return;
+    StopAudioStream(stream);
+    active_mixer = nullptr;
+    UnloadAudioStream(stream);
+}
+
+void SfxMixer::Play(SfxId id, float intensity) {
+    if (!stream_ready) return;
+    commands.Push({id, std::clamp(intensity, 0.0f, 1.0f)});
+}
+
+void SfxMixer::AudioCallback(void* buffer, unsigned int frames) {
+    SfxMixer* mixer = active_mixer.load();
+    if (mixer) {
+        mixer->Mix((float*)buffer, frames);
+    } else {
+        std::fill((float*)buffer, (float*)buffer + frames, 0.0f);
+    }
+}
+
+void SfxMixer::Mix(float* out, unsigned int frames) {
+    // Převzít nové efekty - volný hlas, jinak se přepíše nejstarší
+    Command command;
+    while (commands.Pop(command)) {
+        Voice* target = &voices[0];
+        for (Voice& voice : voices) {
+            if (!voice.active) {
+                target = &voice;
+                break;
+            }
+            if (voice.age < target->age) target = &voice;
+        }
+
+        const Clip& clip = clips[(int)command.id];
+        target->active = clip.length > 0;
+        target->samples = pcm.data() + clip.offset;
+        target->length = clip.length;
+        target->position = 0.0;
+        target->gain = 0.3f + 0.7f * command.intensity;
+        // Větší výbuch zní hlouběji
+        target->step = (command.id == SfxId::EXPLOSION) ? 1.15 - 0.35 * command.intensity : 1.0;
+        target->age = voice_counter++;
+    }
+
+    std::fill(out, out + frames, 0.0f);
+    for (Voice& voice : voices) {
+        if (!voice.active) continue;
+        for (unsigned int i = 0; i < frames; i++) {
+            size_t index = (size_t)voice.position;
+            if (index + 1 >= voice.length) {
+                voice.active = false;
+                break;
+            }
+            float fraction = (float)(voice.position - index);
+            float sample = voice.samples[index] + (voice.samples[index + 1] - voice.samples[index]) * fraction;
+            out[i] += sample * voice.gain;
+            voice.position += voice.step;
+        }
+    }
+
+    for (unsigned int i = 0; i < frames; i++) out[i] = std::clamp(out[i], -1.0f, 1.0f);
+}
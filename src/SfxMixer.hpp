@@ -0,0 +1,116 @@
+#pragma once
+
+#include "raylib.h"
+#include "SpscQueue.hpp"
+#include <vector>
+
+/**
+ * Zvukové efekty herních událostí.
+ */
+enum class SfxId {
+    ROTATE,         // Otočení kostky
+    LOCK,           // Kostka dopadla a přidala se na desku
+    LANDING,        // Dopad padajících částic
+    CHARGE,         // Nabíjení před výbuchem (zoom animace)
+    EXPLOSION,      // Výbuch skupiny
+    COUNT
+};
+
+/**
+ * Mixer zvukových efektů s nízkou latencí.
+ *
+ * Efekty dostane jako hotové PCM (mono float, připraví je Assets na
+ * pracovních vláknech) a při vytvoření je složí do jednoho bloku, který
+ * se pak už nemění. Mixování běží v callbacku audio
+ * zařízení s malým bufferem; herní vlákno jen vloží příkaz do lock-free
+ * fronty (žádné alokace ani zámky), callback ho převezme nejpozději
+ * na začátku dalšího bufferu.
+ */
+class SfxMixer {
+public:
+    /**
+     * Konstruktor - převezme PCM efektů a spustí stream (audio zařízení musí běžet).
+     * @param clip_pcm PCM všech efektů, indexováno SfxId (SfxId::COUNT prvků)
+     */
+    explicit SfxMixer(const std::vector<float>* clip_pcm);
+
+    /**
+     * Destruktor - zastaví a uvolní stream.
+     */
+    ~SfxMixer();
+
+    SfxMixer(const SfxMixer&) = delete;
+    SfxMixer& operator=(const SfxMixer&) = delete;
+
+    /**
+     * Spustí efekt. Volá se jen z herního vlákna, nikdy neblokuje.
+     * @param id Efekt
+     * @param intensity Síla 0.0 - 1.0 (hlasitost, u výbuchu i hloubka tónu)
+     */
+    void Play(SfxId id, float intensity = 1.0f);
+
+    /**
+     * @return Název efektu (soubor assets/sfx/<název>.wav)
+     */
+    static const char* GetClipName(SfxId id);
+
+    /**
+     * Dekóduje efekt ze souboru WAV v paměti na mono float PCM mixeru.
+     * @return false pokud data nejsou platný zvuk
+     */
+    static bool DecodeClip(const unsigned char* data, int size, std::vector<float>& out);
+
+    /**
+     * Syntetizuje výchozí podobu efektu (když chybí soubor).
+     */
+    static std::vector<float> SynthesizeClip(SfxId id);
+
+private:
+    /**
+     * Umístění efektu v bloku PCM.
+     */
+    struct Clip {
+        size_t offset, length;
+    };
+
+    /**
+     * Příkaz z herního vlákna.
+     */
+    struct Command {
+        SfxId id;
+        float intensity;
+    };
+
+    /**
+     * Přehrávaný efekt.
+     */
+    struct Voice {
+        bool active;
+        const float* samples;
+        size_t length;
+        double position;     // Pozice ve vzorcích (necelá kvůli změně výšky)
+        double step;         // Posun za vzorek výstupu
+        float gain;
+        unsigned int age;    // Pořadí spuštění (nejstarší hlas se přepíše)
+    };
+
+    static constexpr int MAX_VOICES = 16;
+
+    std::vector<float> pcm;                      // Všechny efekty za sebou
+    Clip clips[(int)SfxId::COUNT];               // Efekty v bloku pcm
+    Voice voices[MAX_VOICES];                    // Hlasy (jen audio callback)
+    unsigned int voice_counter;                  // Počítadlo spuštění (jen audio callback)
+    SpscQueue<Command, 64> commands;             // Příkazy z herního vlákna
+    AudioStream stream;                          // Výstupní stream raylib
+    bool stream_ready;                           // Stream se podařilo vytvořit
+
+    /**
+     * Smíchá hlasy do výstupního bufferu (audio vlákno).
+     */
+    void Mix(float* out, unsigned int frames);
+
+    /**
+     * Callback raylib nemá uživatelský ukazatel - přes něj se volá aktivní mixer.
+     */
+    static void AudioCallback(void* buffer, unsigned int frames);
+};
@@ -1,7 +1,7 @@
 #pragma once
 
 #include "raymath.h"
-#include <vector>
+#include <array>
 
 /**
  * Vrací definici tvaru tetromina pro daný typ a rotaci.
@@ -20,9 +20,9 @@
  *
  * @param shape_type Typ tvaru (0-6)
  * @param rotation Rotace (0-3, kde 0 = 0°, 1 = 90°, 2 = 180°, 3 = 270°)
- * @return Vektor 4 pozic buněk tvořících tetromino
+ * @return Pole 4 pozic buněk tvořících tetromino (bez alokace)
  */
-inline std::vector<Vector2> GetShape(int shape_type, int rotation) {
+inline std::array<Vector2, 4> GetShape(int shape_type, int rotation) {
     static const Vector2 SHAPES[7][4][4] = {
         // 0: O - čtverec (všechny rotace identické)
         {
@@ -75,10 +75,10 @@ inline std::vector<Vector2> GetShape(int shape_type, int rotation) {
         }
     };
 
-    // Sestavení výsledného vektoru ze statické definice
-    std::vector<Vector2> result;
+    // Sestavení výsledného pole ze statické definice
+    std::array<Vector2, 4> result;
     for (int i = 0; i < 4; i++) {
-        result.push_back(SHAPES[shape_type][rotation][i]);
+        result[i] = SHAPES[shape_type][rotation][i];
     }
     return result;
 }
@@ -0,0 +1,62 @@
+#include "SimulationThread.hpp"
+
+namespace {
+// Větší zpoždění simulace se nedohání - ticky navíc by jen prodloužily výpadek
+constexpr int MAX_CATCH_UP_TICKS = 5;
+}
+
+SimulationThread::SimulationThread(std::function<void()> tick, int ticks_per_second)
+    : tick(std::move(tick)),
+      interval(std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0 / ticks_per_second))),
+      running(false), ticking(false), quitting(false) {
+    worker = std::thread(&SimulationThread::WorkerLoop, this);
+}
+
+SimulationThread::~SimulationThread() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        quitting = true;
+        running = false;
+    }
+    changed.notify_all();
+    worker.join();
+}
+
+void SimulationThread::Start() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        running = true;
+    }
+    changed.notify_all();
+}
+
+void SimulationThread::Stop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    running = false;
+    changed.notify_all();
+    changed.wait(lock, [this] { return !ticking; });
+}
+
+void SimulationThread::WorkerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        changed.wait(lock, [this] { return running || quitting; });
+        if (quitting) return;
+
+        auto next_tick = std::chrono::steady_clock::now();
+        while (running) {
+            // Tick běží bez zámku, Stop počká na jeho konec
+            ticking = true;
+            lock.unlock();
+            tick();
+            lock.lock();
+            ticking = false;
+            changed.notify_all();
+
+            next_tick += interval;
+            auto now = std::chrono::steady_clock::now();
+            if (now - next_tick > interval * MAX_CATCH_UP_TICKS) next_tick = now;
+            changed.wait_until(lock, next_tick, [this] { return !running; });
+        }
+    }
+}
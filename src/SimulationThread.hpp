@@ -0,0 +1,63 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+/**
+ * Vlákno simulace - volá tick hry s pevnou frekvencí nezávisle na
+ * vykreslování. Pomalý snímek tak nezdrží simulaci a těžký tick
+ * (gravitace velké hromady) nezdrží vykreslení.
+ *
+ * Tick běží jen mezi Start a Stop; po návratu ze Stop už žádný tick
+ * neprobíhá a hlavní vlákno smí sahat na herní objekty.
+ */
+class SimulationThread {
+public:
+    /**
+     * Konstruktor - spustí vlákno (zatím bez ticků).
+     * @param tick Funkce jednoho ticku simulace
+     * @param ticks_per_second Frekvence ticků
+     */
+    SimulationThread(std::function<void()> tick, int ticks_per_second);
+
+    /**
+     * Destruktor - zastaví ticky a ukončí vlákno.
+     */
+    ~SimulationThread();
+
+    SimulationThread(const SimulationThread&) = delete;
+    SimulationThread& operator=(const SimulationThread&) = delete;
+
+    /**
+     * Začne tikat (první tick hned).
+     */
+    void Start();
+
+    /**
+     * Přestane tikat a počká na dokončení rozběhnutého ticku.
+     */
+    void Stop();
+
+    /**
+     * @return true mezi Start a Stop (volá jen vlákno, které volá Start/Stop)
+     */
+    bool IsRunning() const { return running; }
+
+private:
+    std::function<void()> tick;                // Tick simulace
+    std::chrono::steady_clock::duration interval;  // Délka jednoho ticku
+    std::mutex mutex;                          // Zámek stavu
+    std::condition_variable changed;           // Signál Start/Stop/konce ticku
+    bool running;                              // Má se tikat
+    bool ticking;                              // Tick právě probíhá
+    bool quitting;                             // Ukončení vlákna
+    std::thread worker;                        // Vlákno simulace
+
+    /**
+     * Smyčka vlákna simulace.
+     */
+    void WorkerLoop();
+};
@@ -0,0 +1,193 @@
+#include "Snapshot.hpp"
+#include "GridCodec.hpp"
+#include "Utils.hpp"
+#include "raylib.h"
+#include <cstdio>
+#include <cstring>
+
+#ifdef _WIN32
+// Na Windows se místo mmap použije načtení souboru přes raylib
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+constexpr char SNAPSHOT_MAGIC[4] = {'S', 'T', 'R', 'X'};
+constexpr unsigned short SNAPSHOT_VERSION = 2;
+
+// Čtení s kontrolou hranic dat
+class Reader {
+public:
+    Reader(const unsigned char* data, size_t size) : cursor(data), end(data + size), ok(true) {}
+
+    template <typename T>
+    T Read() {
+        T value{};
+        if ((size_t)(end - cursor) < sizeof(T)) {
+            ok = false;
+            return value;
+        }
+        std::memcpy(&value, cursor, sizeof(T));
+        cursor += sizeof(T);
+        return value;
+    }
+
+    // Řetězec s délkou (unsigned int) před daty
+    bool ReadString(std::string& text) {
+        unsigned int length = Read<unsigned int>();
+        if (!ok || (size_t)(end - cursor) < length) {
+            ok = false;
+            return false;
+        }
+        text.assign((const char*)cursor, length);
+        cursor += length;
+        return true;
+    }
+
+    PieceSnapshot ReadPiece() {
+        PieceSnapshot piece{};
+        const unsigned char* next = ReadPieceSnapshot(cursor, end, piece);
+        if (next) cursor = next;
+        else ok = false;
+        return piece;
+    }
+
+    const unsigned char* cursor;
+    const unsigned char* end;
+    bool ok;
+};
+
+bool ParseSnapshot(const unsigned char* data, size_t size, GameSnapshot& snapshot) {
+    Reader reader(data, size);
+    if (size < sizeof(SNAPSHOT_MAGIC) || std::memcmp(data, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0) return false;
+    reader.cursor += sizeof(SNAPSHOT_MAGIC);
+    unsigned short version = reader.Read<unsigned short>();
+    if (version < 1 || version > SNAPSHOT_VERSION) return false;
+
+    snapshot.width = reader.Read<unsigned short>();
+    snapshot.height = reader.Read<unsigned short>();
+    snapshot.score = reader.Read<int>();
+    snapshot.fall_speed = reader.Read<int>();
+    snapshot.fall_counter = reader.Read<int>();
+    snapshot.num_colors = reader.Read<unsigned char>();
+    snapshot.waiting_for_settlement = reader.Read<unsigned char>() != 0;
+    snapshot.current = reader.ReadPiece();
+    snapshot.next = reader.ReadPiece();
+    // Rozměry mimo povolené meze desky odmítnout dřív, než se podle nich alokuje;
+    // počet barev jde rovnou do NUM_COLORS (indexuje ALL_COLORS)
+    if (!reader.ok || !IsSupportedBoardSize(snapshot.width, snapshot.height) ||
+        !IsSupportedColorCount(snapshot.num_colors)) return false;
+
+    if (!reader.ReadString(snapshot.rng_state)) return false;
+    // Stav RNG desky je až od verze 2
+    snapshot.board_rng_state.clear();
+    if (version >= 2 && !reader.ReadString(snapshot.board_rng_state)) return false;
+
+    // Řádky desky (RLE) - dekódují se přímo do jednoho předalokovaného pole
+    snapshot.cells.resize(snapshot.width * snapshot.height);
+    for (int y = 0; y < snapshot.height; y++) {
+        reader.cursor = DecodeRowRLE(reader.cursor, reader.end, &snapshot.cells[y * snapshot.width], snapshot.width);
+        if (!reader.cursor) return false;
+    }
+
+    unsigned int velocity_count = reader.Read<unsigned int>();
+    if (!reader.ok || (size_t)(reader.end - reader.cursor) < velocity_count) return false;
+    snapshot.velocities.assign((const signed char*)reader.cursor, (const signed char*)reader.cursor + velocity_count);
+    return true;
+}
+}
+
+void AppendPieceSnapshot(std::vector<unsigned char>& out, const PieceSnapshot& piece) {
+    AppendValue<unsigned char>(out, (unsigned char)piece.shape_type);
+    AppendValue<unsigned char>(out, (unsigned char)piece.rotation);
+    AppendValue<unsigned char>(out, (unsigned char)piece.color_index);
+    AppendValue<unsigned char>(out, piece.is_active ? 1 : 0);
+    AppendValue<short>(out, (short)piece.board_x);
+    AppendValue<short>(out, (short)piece.board_y);
+}
+
+const unsigned char* ReadPieceSnapshot(const unsigned char* data, const unsigned char* end, PieceSnapshot& piece) {
+    constexpr size_t PIECE_SIZE = 4 + 2 * sizeof(short);
+    if ((size_t)(end - data) < PIECE_SIZE) return nullptr;
+
+    short x, y;
+    std::memcpy(&x, data + 4, sizeof(x));
+    std::memcpy(&y, data + 6, sizeof(y));
+    piece.shape_type = data[0];
+    piece.rotation = data[1];
+    piece.color_index = data[2];
+    piece.is_active = data[3] != 0;
+    piece.board_x = x;
+    piece.board_y = y;
+    if (piece.shape_type > 6 || piece.rotation > 3) return nullptr;
+    return data + PIECE_SIZE;
+}
+
+bool SaveGameSnapshot(const char* path, const GameSnapshot& snapshot) {
+    std::vector<unsigned char> out;
+    out.reserve(256 + snapshot.rng_state.size() + snapshot.board_rng_state.size() + snapshot.cells.size() / 4);
+
+    out.insert(out.end(), SNAPSHOT_MAGIC, SNAPSHOT_MAGIC + sizeof(SNAPSHOT_MAGIC));
+    AppendValue<unsigned short>(out, SNAPSHOT_VERSION);
+    AppendValue<unsigned short>(out, (unsigned short)snapshot.width);
+    AppendValue<unsigned short>(out, (unsigned short)snapshot.height);
+    AppendValue<int>(out, snapshot.score);
+    AppendValue<int>(out, snapshot.fall_speed);
+    AppendValue<int>(out, snapshot.fall_counter);
+    AppendValue<unsigned char>(out, (unsigned char)snapshot.num_colors);
+    AppendValue<unsigned char>(out, snapshot.waiting_for_settlement ? 1 : 0);
+    AppendPieceSnapshot(out, snapshot.current);
+    AppendPieceSnapshot(out, snapshot.next);
+
+    AppendValue<unsigned int>(out, (unsigned int)snapshot.rng_state.size());
+    out.insert(out.end(), snapshot.rng_state.begin(), snapshot.rng_state.end());
+    AppendValue<unsigned int>(out, (unsigned int)snapshot.board_rng_state.size());
+    out.insert(out.end(), snapshot.board_rng_state.begin(), snapshot.board_rng_state.end());
+
+    for (int y = 0; y < snapshot.height; y++) {
+        EncodeRowRLE(&snapshot.cells[y * snapshot.width], snapshot.width, out);
+    }
+
+    AppendValue<unsigned int>(out, (unsigned int)snapshot.velocities.size());
+    out.insert(out.end(), snapshot.velocities.begin(), snapshot.velocities.end());
+
+    // Zapsat do dočasného souboru a pak ho přejmenovat (na POSIX rename
+    // nahradí cíl atomicky, Windows neumí přejmenovat na existující soubor)
+    std::string temp_path = std::string(path) + ".tmp";
+    if (!SaveFileData(temp_path.c_str(), out.data(), (int)out.size())) return false;
+#ifdef _WIN32
+    std::remove(path);
+#endif
+    return std::rename(temp_path.c_str(), path) == 0;
+}
+
+bool LoadGameSnapshot(const char* path, GameSnapshot& snapshot) {
+#ifdef _WIN32
+    int size = 0;
+    unsigned char* data = LoadFileData(path, &size);
+    if (!data) return false;
+    bool ok = ParseSnapshot(data, (size_t)size, snapshot);
+    UnloadFileData(data);
+    return ok;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        close(fd);
+        return false;
+    }
+
+    void* mapped = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) return false;
+
+    bool ok = ParseSnapshot((const unsigned char*)mapped, (size_t)info.st_size, snapshot);
+    munmap(mapped, (size_t)info.st_size);
+    return ok;
+#endif
+}
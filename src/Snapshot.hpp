@@ -0,0 +1,75 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+/**
+ * Stav tetromina uložený ve snímku.
+ */
+struct PieceSnapshot {
+    int shape_type;     // Typ tvaru (0-6)
+    int rotation;       // Rotace (0-3)
+    int color_index;    // Index barvy v ALL_COLORS
+    int board_x;        // Pozice x v buňkách desky
+    int board_y;        // Pozice y v buňkách desky
+    bool is_active;     // Kostka ještě padá
+};
+
+/**
+ * Kompletní uložitelný stav rozehrané hry.
+ * Deska je uložena jako kódy buněk (viz GridCodec.hpp), rychlosti
+ * se ukládají jen pro neusazené částice v pořadí řádek po řádku.
+ */
+struct GameSnapshot {
+    int width, height;                      // Rozměry desky v buňkách částic
+    std::vector<unsigned char> cells;       // Kódy buněk (width * height)
+    std::vector<signed char> velocities;    // velocity_y neusazených částic
+    PieceSnapshot current;                  // Padající tetromino
+    PieceSnapshot next;                     // Náhled další kostky
+    int score;                              // Skóre
+    int fall_speed;                         // Aktuální rychlost pádu
+    int fall_counter;                       // Počítadlo pádu
+    int num_colors;                         // Obtížnost (počet barev)
+    bool waiting_for_settlement;            // Čeká se na usazení před spawnem
+    std::string rng_state;                  // Textový stav generátoru gen
+    std::string board_rng_state;            // Textový stav generátoru desky (Board::rng)
+};
+
+/**
+ * Připojí stav kostky v binární podobě (10 bajtů) - sdílí snímky a stream pro diváky.
+ * @param out Výstupní buffer
+ * @param piece Stav kostky
+ */
+void AppendPieceSnapshot(std::vector<unsigned char>& out, const PieceSnapshot& piece);
+
+/**
+ * Přečte stav kostky zapsaný přes AppendPieceSnapshot.
+ * @param data Začátek dat
+ * @param end Konec dostupných dat
+ * @param piece Výstupní stav kostky
+ * @return Ukazatel za přečtená data, nebo nullptr při chybě
+ */
+const unsigned char* ReadPieceSnapshot(const unsigned char* data, const unsigned char* end, PieceSnapshot& piece);
+
+/**
+ * Uloží snímek hry do binárního souboru.
+ *
+ * Formát (verze 2, little endian): hlavička "STRX" + verze, rozměry,
+ * herní hodnoty a obě kostky, stav RNG hry a desky, RLE řádky desky
+ * a nakonec rychlosti neusazených částic. Verze 1 (bez RNG desky) se
+ * stále načte. Plná deska 50×100 zabere jednotky kB.
+ * Zápis jde přes dočasný soubor, takže se nepoškodí předchozí uložení.
+ *
+ * @param path Cesta k souboru
+ * @param snapshot Snímek k uložení
+ * @return true při úspěchu
+ */
+bool SaveGameSnapshot(const char* path, const GameSnapshot& snapshot);
+
+/**
+ * Načte snímek hry ze souboru namapovaného do paměti (mmap).
+ * @param path Cesta k souboru
+ * @param snapshot Výstupní snímek
+ * @return true při úspěchu, false pokud soubor chybí nebo je poškozený
+ */
+bool LoadGameSnapshot(const char* path, GameSnapshot& snapshot);
@@ -0,0 +1,473 @@
+#include "SpectatorStream.hpp"
+#include "GridCodec.hpp"
+#include "Utils.hpp"
+#include "raylib.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#ifdef _WIN32
+// Unix domain sockety nejsou k dispozici - vysílání i divák zůstanou vypnuté
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace {
+constexpr char STREAM_MAGIC[4] = {'S', 'T', 'R', 'S'};
+constexpr unsigned short STREAM_VERSION = 1;
+constexpr size_t STREAM_HEADER_SIZE = sizeof(STREAM_MAGIC) + 3 * sizeof(unsigned short);
+constexpr unsigned short ROW_END = 0xFFFF;      // Konec seznamu řádků ve snímku
+constexpr unsigned char FLAG_KEYFRAME = 1;      // Snímek obsahuje všechny řádky
+constexpr unsigned char FLAG_GAME_OVER = 2;     // Hra skončila
+
+// Tenká vrstva nad sockety - vrací počet bajtů, 0 = operace by blokovala, -1 = chyba/odpojení
+#ifdef _WIN32
+int SendSome(int, const unsigned char*, size_t) { return -1; }
+int RecvSome(int, unsigned char*, size_t) { return -1; }
+void CloseSocket(int) {}
+#else
+int SendSome(int fd, const unsigned char* data, size_t size) {
+#ifdef MSG_NOSIGNAL
+    const int flags = MSG_NOSIGNAL;   // Odpojený divák nesmí ukončit hru signálem SIGPIPE
+#else
+    const int flags = 0;              // macOS: SIGPIPE vypíná SO_NOSIGPIPE při accept
+#endif
+    for (;;) {
+        ssize_t sent = send(fd, data, size, flags);
+        if (sent >= 0) return (int)sent;
+        if (errno == EINTR) continue;
+        return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+    }
+}
+
+int RecvSome(int fd, unsigned char* data, size_t size) {
+    for (;;) {
+        ssize_t received = recv(fd, data, size, 0);
+        if (received > 0) return (int)received;
+        if (received == 0) return -1;   // Druhá strana zavřela spojení
+        if (errno == EINTR) continue;
+        return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+    }
+}
+
+void CloseSocket(int fd) {
+    close(fd);
+}
+
+bool SetNonBlocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+bool MakeAddress(const char* path, sockaddr_un& address) {
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (std::strlen(path) >= sizeof(address.sun_path)) return false;
+    std::strncpy(address.sun_path, path, sizeof(address.sun_path) - 1);
+    return true;
+}
+#endif
+}
+
+SpectatorPublisher::SpectatorPublisher(const char* socket_path, int width, int height, int queue_capacity)
+    : listen_fd(-1), socket_path(socket_path), width(width), height(height),
+      queue_capacity(std::max(1, queue_capacity)), tick(0), merged_frames(0), stopping(false) {
+#ifdef _WIN32
+    TraceLog(LOG_WARNING, "SPECTATOR: Publishing is not supported on this platform");
+#else
+    sockaddr_un address;
+    if (!MakeAddress(socket_path, address)) {
+        TraceLog(LOG_WARNING, "SPECTATOR: Socket path too long: %s", socket_path);
+        return;
+    }
+
+    unlink(socket_path);
+    listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd < 0 || bind(listen_fd, (const sockaddr*)&address, sizeof(address)) != 0 ||
+        listen(listen_fd, 4) != 0 || !SetNonBlocking(listen_fd)) {
+        TraceLog(LOG_WARNING, "SPECTATOR: Failed to listen on %s", socket_path);
+        if (listen_fd >= 0) CloseSocket(listen_fd);
+        listen_fd = -1;
+        return;
+    }
+
+    shadow.assign(width * height, CELL_EMPTY);
+    mirror.assign(width * height, CELL_EMPTY);
+    seen_versions.assign(height, 0);
+    row_buffer.resize(width);
+    sender = std::thread(&SpectatorPublisher::SenderLoop, this);
+    TraceLog(LOG_INFO, "SPECTATOR: Publishing on %s", socket_path);
+#endif
+}
+
+SpectatorPublisher::~SpectatorPublisher() {
+    if (listen_fd < 0) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    queue_changed.notify_one();
+    sender.join();
+
+    for (Client& client : clients) {
+        if (client.fd >= 0) CloseSocket(client.fd);
+    }
+    CloseSocket(listen_fd);
+#ifndef _WIN32
+    unlink(socket_path.c_str());
+#endif
+    if (merged_frames > 0) {
+        TraceLog(LOG_INFO, "SPECTATOR: %d frames merged (sender too slow)", merged_frames);
+    }
+}
+
+void SpectatorPublisher::AddExplosion(int color_index, int grains) {
+    if (listen_fd < 0) return;
+    pending_events.push_back({color_index, grains});
+}
+
+void SpectatorPublisher::Resync() {
+    std::fill(seen_versions.begin(), seen_versions.end(), 0);
+}
+
+void SpectatorPublisher::PublishTick(Board& board, const SpectatorState& state) {
+    // Hlavička vysílání nese rozměr ze startu - deska jiného rozměru (pokračování
+    // hry uložené s jiným --board) se nevysílá
+    if (listen_fd < 0 || board.width != width || board.height != height) return;
+    if (board.grid_dirty) board.RebuildGrid();
+
+    // Vzít recyklovaný snímek (buffery si drží kapacitu)
+    Frame frame;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!free_frames.empty()) {
+            frame = std::move(free_frames.back());
+            free_frames.pop_back();
+        }
+    }
+    frame.tick = tick++;
+    frame.state = state;
+    frame.events.swap(pending_events);
+    pending_events.clear();
+    frame.rows.clear();
+    frame.cells.clear();
+
+    // Jen řádky se změněnou verzí, a z nich jen ty, které se opravdu liší
+    for (int y = 0; y < height; y++) {
+        if (board.row_versions[y] == seen_versions[y]) continue;
+        seen_versions[y] = board.row_versions[y];
+
+        CaptureGridRow(board, y, row_buffer.data());
+        unsigned char* old_row = &shadow[y * width];
+        if (std::equal(row_buffer.begin(), row_buffer.end(), old_row)) continue;
+
+        std::copy(row_buffer.begin(), row_buffer.end(), old_row);
+        frame.rows.push_back((unsigned short)y);
+        frame.cells.insert(frame.cells.end(), row_buffer.begin(), row_buffer.end());
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if ((int)queue.size() >= queue_capacity) {
+            // Vysílání nestíhá - sloučit s posledním čekajícím snímkem
+            MergeFrame(queue.back(), frame);
+            merged_frames++;
+            free_frames.push_back(std::move(frame));
+        } else {
+            queue.push_back(std::move(frame));
+        }
+    }
+    queue_changed.notify_one();
+}
+
+void SpectatorPublisher::MergeFrame(Frame& into, const Frame& from) {
+    into.tick = from.tick;
+    into.state = from.state;
+    into.events.insert(into.events.end(), from.events.begin(), from.events.end());
+
+    for (size_t i = 0; i < from.rows.size(); i++) {
+        const unsigned char* row = &from.cells[i * width];
+        auto existing = std::find(into.rows.begin(), into.rows.end(), from.rows[i]);
+        if (existing != into.rows.end()) {
+            std::copy(row, row + width, into.cells.begin() + (existing - into.rows.begin()) * width);
+        } else {
+            into.rows.push_back(from.rows[i]);
+            into.cells.insert(into.cells.end(), row, row + width);
+        }
+    }
+}
+
+void SpectatorPublisher::EncodeMessage(const Frame& frame, bool keyframe, std::vector<unsigned char>& out) const {
+    out.clear();
+    AppendValue<unsigned int>(out, 0); // Délka zprávy se doplní po zakódování
+    AppendValue<unsigned int>(out, frame.tick);
+    unsigned char flags = (keyframe ? FLAG_KEYFRAME : 0) | (frame.state.game_over ? FLAG_GAME_OVER : 0);
+    AppendValue<unsigned char>(out, flags);
+    AppendValue<int>(out, frame.state.score);
+    AppendValue<unsigned char>(out, (unsigned char)frame.state.num_colors);
+    AppendPieceSnapshot(out, frame.state.current);
+    AppendPieceSnapshot(out, frame.state.next);
+
+    AppendValue<unsigned short>(out, (unsigned short)frame.events.size());
+    for (const ExplosionEvent& event : frame.events) {
+        AppendValue<unsigned char>(out, (unsigned char)event.color_index);
+        AppendValue<unsigned int>(out, (unsigned int)event.grains);
+    }
+
+    if (keyframe) {
+        for (int y = 0; y < height; y++) {
+            AppendValue<unsigned short>(out, (unsigned short)y);
+            EncodeRowRLE(&mirror[y * width], width, out);
+        }
+    } else {
+        for (size_t i = 0; i < frame.rows.size(); i++) {
+            AppendValue<unsigned short>(out, frame.rows[i]);
+            EncodeRowRLE(&frame.cells[i * width], width, out);
+        }
+    }
+    AppendValue<unsigned short>(out, ROW_END);
+
+    unsigned int payload_size = (unsigned int)(out.size() - sizeof(unsigned int));
+    std::memcpy(out.data(), &payload_size, sizeof(payload_size));
+}
+
+void SpectatorPublisher::SenderLoop() {
+    Frame frame;
+    for (;;) {
+        bool has_frame = false;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            // Časový limit - diváci se přijímají i když hra stojí (menu, pauza)
+            queue_changed.wait_for(lock, std::chrono::milliseconds(50),
+                                   [this] { return stopping || !queue.empty(); });
+            if (stopping) return;
+            if (!queue.empty()) {
+                frame = std::move(queue.front());
+                queue.pop_front();
+                has_frame = true;
+            }
+        }
+
+        AcceptClients();
+
+        if (has_frame) {
+            for (size_t i = 0; i < frame.rows.size(); i++) {
+                std::copy(&frame.cells[i * width], &frame.cells[i * width] + width, &mirror[frame.rows[i] * width]);
+            }
+            EncodeMessage(frame, false, delta_message);
+
+            bool key_encoded = false;
+            for (Client& client : clients) {
+                if (!FlushClient(client)) continue;
+                if (!client.pending.empty()) {
+                    // Divák nestíhá - snímek vynechat, po dohnání dostane klíčový
+                    client.needs_keyframe = true;
+                    continue;
+                }
+                if (client.needs_keyframe && !key_encoded) {
+                    EncodeMessage(frame, true, key_message);
+                    key_encoded = true;
+                }
+                const std::vector<unsigned char>& message = client.needs_keyframe ? key_message : delta_message;
+                client.needs_keyframe = false;
+                client.pending.assign(message.begin(), message.end());
+                client.pending_offset = 0;
+                FlushClient(client);
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            free_frames.push_back(std::move(frame));
+        } else {
+            for (Client& client : clients) FlushClient(client);
+        }
+
+        clients.erase(std::remove_if(clients.begin(), clients.end(), [](const Client& c) { return c.fd < 0; }),
+                      clients.end());
+    }
+}
+
+void SpectatorPublisher::AcceptClients() {
+#ifndef _WIN32
+    for (;;) {
+        int fd = accept(listen_fd, nullptr, nullptr);
+        if (fd < 0) return;
+        if (!SetNonBlocking(fd)) {
+            CloseSocket(fd);
+            continue;
+        }
+#ifdef SO_NOSIGPIPE
+        int one = 1;
+        setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+
+        Client client;
+        client.fd = fd;
+        client.pending.assign(STREAM_MAGIC, STREAM_MAGIC + sizeof(STREAM_MAGIC));
+        AppendValue<unsigned short>(client.pending, STREAM_VERSION);
+        AppendValue<unsigned short>(client.pending, (unsigned short)width);
+        AppendValue<unsigned short>(client.pending, (unsigned short)height);
+        client.pending_offset = 0;
+        client.needs_keyframe = true;
+        clients.push_back(std::move(client));
+        TraceLog(LOG_INFO, "SPECTATOR: Viewer connected (%d total)", (int)clients.size());
+    }
+#endif
+}
+
+bool SpectatorPublisher::FlushClient(Client& client) {
+    if (client.fd < 0) return false;
+    while (client.pending_offset < client.pending.size()) {
+        int sent = SendSome(client.fd, &client.pending[client.pending_offset],
+                            client.pending.size() - client.pending_offset);
+        if (sent == 0) return true;     // Buffer socketu je plný, zbytek počká
+        if (sent < 0) {
+            CloseSocket(client.fd);
+            client.fd = -1;
+            return false;
+        }
+        client.pending_offset += sent;
+    }
+    client.pending.clear();
+    client.pending_offset = 0;
+    return true;
+}
+
+SpectatorClient::SpectatorClient()
+    : width(0), height(0), state{}, tick(0), board_changed(false), fd(-1), has_header(false) {}
+
+SpectatorClient::~SpectatorClient() {
+    Disconnect();
+}
+
+bool SpectatorClient::Connect(const char* socket_path) {
+    Disconnect();
+#ifdef _WIN32
+    (void)socket_path;
+    return false;
+#else
+    sockaddr_un address;
+    if (!MakeAddress(socket_path, address)) return false;
+
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return false;
+    if (connect(fd, (const sockaddr*)&address, sizeof(address)) != 0 || !SetNonBlocking(fd)) {
+        Disconnect();
+        return false;
+    }
+#ifdef SO_NOSIGPIPE
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+    return true;
+#endif
+}
+
+void SpectatorClient::Disconnect() {
+    if (fd >= 0) CloseSocket(fd);
+    fd = -1;
+    has_header = false;
+    buffer.clear();
+}
+
+int SpectatorClient::Poll() {
+    if (fd < 0) return 0;
+
+    unsigned char chunk[16 * 1024];
+    for (;;) {
+        int received = RecvSome(fd, chunk, sizeof(chunk));
+        if (received == 0) break;
+        if (received < 0) {
+            Disconnect();
+            return 0;
+        }
+        buffer.insert(buffer.end(), chunk, chunk + received);
+    }
+
+    size_t offset = 0;
+    if (!has_header) {
+        if (buffer.size() < STREAM_HEADER_SIZE) return 0;
+        unsigned short header[3];
+        std::memcpy(header, &buffer[sizeof(STREAM_MAGIC)], sizeof(header));
+        // Rozměry mimo meze desky odmítnout dřív, než se podle nich alokuje
+        if (std::memcmp(buffer.data(), STREAM_MAGIC, sizeof(STREAM_MAGIC)) != 0 || header[0] != STREAM_VERSION ||
+            !IsSupportedBoardSize(header[1], header[2])) {
+            TraceLog(LOG_WARNING, "SPECTATOR: Invalid stream header");
+            Disconnect();
+            return 0;
+        }
+        width = header[1];
+        height = header[2];
+        cells.assign(width * height, CELL_EMPTY);
+        has_header = true;
+        board_changed = true;
+        offset = STREAM_HEADER_SIZE;
+    }
+
+    // Aplikovat všechny celé snímky, neúplný zbytek počká na další data
+    int applied = 0;
+    while (buffer.size() - offset >= sizeof(unsigned int)) {
+        unsigned int size;
+        std::memcpy(&size, &buffer[offset], sizeof(size));
+        if (buffer.size() - offset - sizeof(size) < size) break;
+
+        const unsigned char* message = &buffer[offset + sizeof(size)];
+        if (!ApplyMessage(message, message + size)) {
+            TraceLog(LOG_WARNING, "SPECTATOR: Corrupted frame");
+            Disconnect();
+            return applied;
+        }
+        offset += sizeof(size) + size;
+        applied++;
+    }
+    buffer.erase(buffer.begin(), buffer.begin() + offset);
+    return applied;
+}
+
+bool SpectatorClient::ApplyMessage(const unsigned char* data, const unsigned char* end) {
+    constexpr size_t FIXED_SIZE = 4 + 1 + 4 + 1;  // tick + příznaky + skóre + obtížnost
+    if ((size_t)(end - data) < FIXED_SIZE) return false;
+
+    unsigned char flags = data[4];
+    int score;
+    std::memcpy(&tick, data, sizeof(tick));
+    std::memcpy(&score, data + 5, sizeof(score));
+    if (!IsSupportedColorCount(data[9])) return false;
+    state.score = score;
+    state.num_colors = data[9];
+    state.game_over = (flags & FLAG_GAME_OVER) != 0;
+    const unsigned char* cursor = data + FIXED_SIZE;
+
+    cursor = ReadPieceSnapshot(cursor, end, state.current);
+    if (cursor) cursor = ReadPieceSnapshot(cursor, end, state.next);
+    if (!cursor || end - cursor < (int)sizeof(unsigned short)) return false;
+
+    unsigned short event_count;
+    std::memcpy(&event_count, cursor, sizeof(event_count));
+    cursor += sizeof(event_count);
+    constexpr size_t EVENT_SIZE = 1 + 4;
+    if ((size_t)(end - cursor) < event_count * EVENT_SIZE) return false;
+    for (int i = 0; i < event_count; i++) {
+        unsigned int grains;
+        std::memcpy(&grains, cursor + 1, sizeof(grains));
+        events.push_back({cursor[0], (int)grains});
+        cursor += EVENT_SIZE;
+    }
+
+    for (;;) {
+        unsigned short y;
+        if (end - cursor < (int)sizeof(y)) return false;
+        std::memcpy(&y, cursor, sizeof(y));
+        cursor += sizeof(y);
+        if (y == ROW_END) break;
+        if (y >= height) return false;
+
+        cursor = DecodeRowRLE(cursor, end, &cells[y * width], width);
+        if (!cursor) return false;
+        board_changed = true;
+    }
+    return true;
+}
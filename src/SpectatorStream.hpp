@@ -0,0 +1,225 @@
+#pragma once
+
+#include "Board.hpp"
+#include "Snapshot.hpp"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Stav hry mimo desku, který se vysílá divákům v každém ticku.
+ */
+struct SpectatorState {
+    PieceSnapshot current;  // Padající tetromino
+    PieceSnapshot next;     // Náhled další kostky
+    int score;              // Skóre
+    int num_colors;         // Obtížnost (počet barev)
+    bool game_over;         // Hra skončila
+};
+
+/**
+ * Událost výbuchu - spuštění zoom animace skupiny částic.
+ */
+struct ExplosionEvent {
+    int color_index;        // Barva vybuchující skupiny (index v ALL_COLORS)
+    int grains;             // Počet odstraněných částic
+};
+
+/**
+ * Vysílání průběhu hry divákům přes Unix domain socket (--publish).
+ *
+ * Protokol (little endian): po připojení hlavička "STRS" + verze, šířka
+ * a výška desky, pak snímky {délka, tick, příznaky, skóre, obtížnost, obě
+ * kostky, výbuchy, změněné řádky}. Řádek je {index, RLE obsah řádku}
+ * (viz GridCodec.hpp), seznam končí indexem 0xFFFF. Řádky nesou celý nový
+ * obsah, ne XOR, takže dva snímky jdou sloučit a klíčový snímek je jen
+ * snímek se všemi řádky.
+ *
+ * Herní smyčka jen porovná řádky se změněnou verzí a předá je do omezené
+ * fronty - nikdy neblokuje na socketu. Při plné frontě se nový snímek
+ * sloučí s posledním čekajícím. Vysílací vlákno drží vlastní kopii desky:
+ * nový divák, nebo divák, který nestíhá číst (neodeslaný zbytek minulého
+ * snímku), snímky vynechá a po dohnání dostane klíčový snímek.
+ * Na Windows je vysílání vypnuté (IsOpen vrací false).
+ */
+class SpectatorPublisher {
+public:
+    /**
+     * Konstruktor - vytvoří naslouchající socket a spustí vysílací vlákno.
+     * @param socket_path Cesta k socketu (existující soubor se přepíše)
+     * @param width Šířka desky v buňkách částic
+     * @param height Výška desky v buňkách částic
+     * @param queue_capacity Maximální počet snímků čekajících na odeslání
+     */
+    SpectatorPublisher(const char* socket_path, int width, int height, int queue_capacity = 8);
+
+    /**
+     * Destruktor - ukončí vlákno, odpojí diváky a smaže socket.
+     */
+    ~SpectatorPublisher();
+
+    SpectatorPublisher(const SpectatorPublisher&) = delete;
+    SpectatorPublisher& operator=(const SpectatorPublisher&) = delete;
+
+    /**
+     * @return true pokud socket naslouchá
+     */
+    bool IsOpen() const { return listen_fd >= 0; }
+
+    /**
+     * Zapamatuje výbuch, odešle se s nejbližším snímkem.
+     * @param color_index Barva skupiny
+     * @param grains Počet odstraněných částic
+     */
+    void AddExplosion(int color_index, int grains);
+
+    /**
+     * Porovná desku s posledním vysílaným stavem a zařadí snímek do fronty.
+     * @param board Deska (jiné rozměry než v konstruktoru se nevysílají)
+     * @param state Herní hodnoty mimo desku
+     */
+    void PublishTick(Board& board, const SpectatorState& state);
+
+    /**
+     * Vynutí porovnání všech řádků v příštím ticku (nová nebo načtená deska).
+     */
+    void Resync();
+
+    /**
+     * @return Počet snímků sloučených kvůli plné frontě
+     */
+    int GetMergedFrames() const { return merged_frames; }
+
+private:
+    /**
+     * Snímek čekající na odeslání - změněné řádky v kódech buněk.
+     */
+    struct Frame {
+        unsigned int tick;
+        SpectatorState state;
+        std::vector<ExplosionEvent> events;
+        std::vector<unsigned short> rows;      // Indexy změněných řádků
+        std::vector<unsigned char> cells;      // Obsah řádků (width buněk na řádek)
+    };
+
+    /**
+     * Připojený divák.
+     */
+    struct Client {
+        int fd;
+        std::vector<unsigned char> pending;    // Neodeslaný zbytek dat
+        size_t pending_offset;                 // Kolik z pending už odešlo
+        bool needs_keyframe;                   // Vynechal snímky - čeká na klíčový
+    };
+
+    int listen_fd;                             // Naslouchající socket (-1 = vypnuto)
+    std::string socket_path;                   // Cesta k socketu
+    int width, height;                         // Rozměry desky
+    int queue_capacity;                        // Kapacita fronty
+    unsigned int tick;                         // Číslo dalšího snímku
+    int merged_frames;                         // Počet sloučených snímků
+
+    // Herní vlákno
+    std::vector<unsigned char> shadow;         // Naposledy vysílaný stav desky
+    std::vector<unsigned int> seen_versions;   // Verze řádků odpovídající stínu
+    std::vector<unsigned char> row_buffer;     // Pracovní řádek
+    std::vector<ExplosionEvent> pending_events;  // Výbuchy od posledního snímku
+
+    // Sdílené s vysílacím vláknem
+    std::deque<Frame> queue;                   // Snímky čekající na odeslání
+    std::vector<Frame> free_frames;            // Recyklované snímky
+    std::mutex mutex;                          // Zámek fronty
+    std::condition_variable queue_changed;     // Signál nového snímku / ukončení
+    bool stopping;                             // Příznak ukončení vlákna
+    std::thread sender;                        // Vysílací vlákno
+
+    // Vysílací vlákno
+    std::vector<unsigned char> mirror;         // Stav desky po posledním odeslaném snímku
+    std::vector<Client> clients;               // Připojení diváci
+    std::vector<unsigned char> delta_message;  // Zakódovaný snímek se změnami
+    std::vector<unsigned char> key_message;    // Zakódovaný klíčový snímek
+
+    /**
+     * Sloučí snímek do staršího čekajícího snímku (novější řádky a stav vyhrávají).
+     */
+    void MergeFrame(Frame& into, const Frame& from);
+
+    /**
+     * Zakóduje snímek do zprávy protokolu.
+     * @param keyframe true = všechny řádky z mirror, jinak jen řádky snímku
+     */
+    void EncodeMessage(const Frame& frame, bool keyframe, std::vector<unsigned char>& out) const;
+
+    /**
+     * Smyčka vysílacího vlákna.
+     */
+    void SenderLoop();
+
+    /**
+     * Přijme čekající diváky (neblokující accept).
+     */
+    void AcceptClients();
+
+    /**
+     * Pokusí se odeslat neodeslaný zbytek dat diváka.
+     * @return false pokud se divák odpojil
+     */
+    bool FlushClient(Client& client);
+};
+
+/**
+ * Divák - čte stream z SpectatorPublisher a udržuje poslední přijatý stav.
+ * Nic nesimuluje, jen skládá řádky desky ze snímků.
+ */
+class SpectatorClient {
+public:
+    int width, height;                     // Rozměry desky (0 dokud nedorazí hlavička)
+    std::vector<unsigned char> cells;      // Kódy buněk desky (width * height)
+    SpectatorState state;                  // Poslední přijaté herní hodnoty
+    unsigned int tick;                     // Tick posledního přijatého snímku
+    std::vector<ExplosionEvent> events;    // Výbuchy přijaté od posledního vyprázdnění
+    bool board_changed;                    // Deska se změnila (nuluje volající)
+
+    SpectatorClient();
+    ~SpectatorClient();
+
+    SpectatorClient(const SpectatorClient&) = delete;
+    SpectatorClient& operator=(const SpectatorClient&) = delete;
+
+    /**
+     * Připojí se k vysílání.
+     * @param socket_path Cesta k socketu
+     * @return false pokud vysílání neběží
+     */
+    bool Connect(const char* socket_path);
+
+    /**
+     * @return true pokud je divák připojený
+     */
+    bool IsConnected() const { return fd >= 0; }
+
+    /**
+     * Přečte dostupná data (neblokuje) a aplikuje všechny celé snímky.
+     * @return Počet aplikovaných snímků
+     */
+    int Poll();
+
+private:
+    int fd;                                // Socket (-1 = odpojeno)
+    bool has_header;                       // Hlavička streamu už dorazila
+    std::vector<unsigned char> buffer;     // Přijatá, zatím nezpracovaná data
+
+    /**
+     * Aplikuje jeden snímek.
+     * @return false pokud jsou data poškozená
+     */
+    bool ApplyMessage(const unsigned char* data, const unsigned char* end);
+
+    /**
+     * Zavře socket.
+     */
+    void Disconnect();
+};
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+/**
+ * Lock-free fronta pro jednoho producenta a jednoho konzumenta.
+ * Pevná kapacita, žádné alokace - Push i Pop jsou bezpečné i v audio
+ * callbacku. Při plné frontě Push vrátí false a prvek se zahodí.
+ * @tparam T Typ prvku (kopíruje se)
+ * @tparam Capacity Počet slotů (použitelná kapacita je o jeden menší)
+ */
+template <typename T, size_t Capacity>
+class SpscQueue {
+public:
+    SpscQueue() : head(0), tail(0) {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    /**
+     * Vloží prvek (volá jen producent).
+     * @return false pokud je fronta plná
+     */
+    bool Push(const T& item) {
+        size_t current_tail = tail.load(std::memory_order_relaxed);
+        size_t next_tail = (current_tail + 1) % Capacity;
+        if (next_tail == head.load(std::memory_order_acquire)) return false;
+        items[current_tail] = item;
+        tail.store(next_tail, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Vyjme nejstarší prvek (volá jen konzument).
+     * @return false pokud je fronta prázdná
+     */
+    bool Pop(T& item) {
+        size_t current_head = head.load(std::memory_order_relaxed);
+        if (current_head == tail.load(std::memory_order_acquire)) return false;
+        item = items[current_head];
+        head.store((current_head + 1) % Capacity, std::memory_order_release);
+        return true;
+    }
+
+private:
+    T items[Capacity];
+    alignas(64) std::atomic<size_t> head;   // Čte konzument
+    alignas(64) std::atomic<size_t> tail;   // Zapisuje producent
+};
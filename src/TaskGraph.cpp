@@ -0,0 +1,39 @@
+#include "TaskGraph.hpp"
+
+TaskGraph::TaskGraph() : pool(nullptr) {}
+
+int TaskGraph::AddTask(std::function<void()> work, std::initializer_list<int> dependencies) {
+    int index = (int)tasks.size();
+    auto task = std::make_unique<Task>();
+    task->work = std::move(work);
+    task->dependency_count = (int)dependencies.size();
+    task->remaining = 0;
+    for (int dependency : dependencies) {
+        tasks[dependency]->dependents.push_back(index);
+    }
+    tasks.push_back(std::move(task));
+    return index;
+}
+
+void TaskGraph::Run(ThreadPool& pool) {
+    this->pool = &pool;
+    for (auto& task : tasks) task->remaining = task->dependency_count;
+
+    for (int i = 0; i < (int)tasks.size(); i++) {
+        if (tasks[i]->dependency_count == 0) Schedule(i);
+    }
+
+    // Závislé úlohy se odesílají do skupiny dřív, než jejich předchůdce
+    // skončí, takže skupina nedoběhne před koncem celého grafu
+    pool.Wait(group);
+}
+
+void TaskGraph::Schedule(int index) {
+    pool->Submit([this, index] {
+        Task& task = *tasks[index];
+        task.work();
+        for (int dependent : task.dependents) {
+            if (--tasks[dependent]->remaining == 0) Schedule(dependent);
+        }
+    }, &group);
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "ThreadPool.hpp"
+#include <atomic>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+/**
+ * Graf úloh s deklarovanými závislostmi, spouštěný opakovaně (jednou za tick).
+ * Graf se sestaví jednou, Run pak pustí na pool všechny úlohy bez
+ * závislostí a každou další úlohu hned, jak doběhnou všechny, na kterých
+ * závisí. Nezávislé fáze tak běží souběžně na pracovních vláknech.
+ */
+class TaskGraph {
+public:
+    TaskGraph();
+
+    TaskGraph(const TaskGraph&) = delete;
+    TaskGraph& operator=(const TaskGraph&) = delete;
+
+    /**
+     * Přidá úlohu do grafu.
+     * @param work Práce úlohy
+     * @param dependencies Indexy dříve přidaných úloh, které musí doběhnout první
+     * @return Index úlohy
+     */
+    int AddTask(std::function<void()> work, std::initializer_list<int> dependencies = {});
+
+    /**
+     * Provede celý graf a počká na dokončení; volající vlákno mezitím
+     * zpracovává jen úlohy tohoto grafu, jinak spí.
+     * @param pool Pool, na kterém úlohy běží
+     */
+    void Run(ThreadPool& pool);
+
+private:
+    /**
+     * Uzel grafu.
+     */
+    struct Task {
+        std::function<void()> work;        // Práce úlohy
+        std::vector<int> dependents;       // Úlohy čekající na tuto úlohu
+        int dependency_count;              // Počet závislostí
+        std::atomic<int> remaining;        // Nedokončené závislosti v aktuálním běhu
+    };
+
+    std::vector<std::unique_ptr<Task>> tasks;  // Úlohy v pořadí přidání
+    TaskGroup group;                           // Skupina úloh aktuálního běhu
+    ThreadPool* pool;                          // Pool aktuálního běhu
+
+    /**
+     * Odešle úlohu na pool; po jejím dokončení odešle uvolněné závislé úlohy.
+     */
+    void Schedule(int index);
+};
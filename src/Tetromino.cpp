@@ -4,15 +4,26 @@
 #include <random>
 
 // Konstruktor - vytvoří náhodné tetromino
-Tetromino::Tetromino(int board_x, int board_y)
-    : board_x(board_x), board_y(board_y), rotation(0), is_active(true) {
+Tetromino::Tetromino(int board_x, int board_y, std::mt19937& rng) {
+    // Každý tvar má 4 buňky - kapacita vystačí na celou hru
+    particles.reserve(4 * PARTICLES_PER_BLOCK * PARTICLES_PER_BLOCK);
+    Reset(board_x, board_y, rng);
+}
+
+// Znovu použít tetromino jako nové náhodné
+void Tetromino::Reset(int board_x, int board_y, std::mt19937& rng) {
+    this->board_x = board_x;
+    this->board_y = board_y;
+    rotation = 0;
+    is_active = true;
+
     // Náhodný výběr tvaru (0-6: O, I, T, S, Z, L, J)
     std::uniform_int_distribution<> shape_dist(0, 6);
     // Náhodný výběr barvy z dostupných barev (podle obtížnosti)
     std::uniform_int_distribution<> color_dist(0, NUM_COLORS - 1);
 
-    shape_type = shape_dist(gen);
-    color = ALL_COLORS[color_dist(gen)];
+    shape_type = shape_dist(rng);
+    color = ALL_COLORS[color_dist(rng)];
     GenerateParticles();
 }
 
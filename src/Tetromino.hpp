@@ -2,6 +2,7 @@
 
 #include "raylib.h"
 #include "Particle.hpp"
+#include <random>
 #include <vector>
 
 /**
@@ -22,8 +23,18 @@ public:
      * Konstruktor - vytvoří nové tetromino náhodného tvaru a barvy.
      * @param board_x Počáteční x pozice na desce
      * @param board_y Počáteční y pozice na desce
+     * @param rng Generátor náhody pro tvar a barvu
      */
-    Tetromino(int board_x, int board_y);
+    Tetromino(int board_x, int board_y, std::mt19937& rng);
+
+    /**
+     * Znovu použije objekt jako nové náhodné tetromino (stejné čerpání náhody
+     * jako konstruktor). Vektor částic si drží kapacitu, spawn tak nealokuje.
+     * @param board_x Počáteční x pozice na desce
+     * @param board_y Počáteční y pozice na desce
+     * @param rng Generátor náhody pro tvar a barvu
+     */
+    void Reset(int board_x, int board_y, std::mt19937& rng);
 
     /**
      * Generuje všechny částice pro aktuální tvar a rotaci.
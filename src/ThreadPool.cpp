@@ -0,0 +1,207 @@
+#include "ThreadPool.hpp"
+#include <algorithm>
+
+namespace {
+// Pool a fronta pracovního vlákna, ve kterém kód běží (nullptr / -1 mimo pool)
+thread_local const ThreadPool* current_pool = nullptr;
+thread_local int current_queue = -1;
+}
+
+ThreadPool::ThreadPool(unsigned int thread_count)
+    : next_queue(0), queued_tasks(0), pending_tasks(0), stopping(false) {
+    if (thread_count == 0) {
+        thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+    queues.reserve(thread_count);
+    for (unsigned int i = 0; i < thread_count; i++) {
+        queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    workers.reserve(thread_count);
+    for (unsigned int i = 0; i < thread_count; i++) {
+        workers.emplace_back(&ThreadPool::WorkerLoop, this, (int)i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+        stopping = true;
+    }
+    task_available.notify_all();
+    for (auto& worker : workers) worker.join();
+}
+
+void ThreadPool::Submit(std::function<void()> task, TaskGroup* group) {
+    pending_tasks++;
+    if (group) group->pending++;
+
+    // Z pracovního vlákna do vlastní fronty, zvenku dokola po frontách
+    int index = (current_pool == this) ? current_queue : (int)(next_queue++ % queues.size());
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->PushBack({std::move(task), group});
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+        queued_tasks++;
+    }
+    task_available.notify_one();
+
+    // Probudit vlákno čekající na skupinu, ať úlohu zpracuje samo
+    if (group) {
+        std::lock_guard<std::mutex> lock(group->mutex);
+        group->queued++;
+        group->changed.notify_all();
+    }
+}
+
+void ThreadPool::Wait() {
+    int own_queue = (current_pool == this) ? current_queue : -1;
+    while (pending_tasks > 0) {
+        QueuedTask task;
+        if (PopTask(own_queue, task)) {
+            RunTask(task);
+            continue;
+        }
+        // Zbylé úlohy už běží na jiných vláknech
+        std::unique_lock<std::mutex> lock(sleep_mutex);
+        tasks_finished.wait(lock, [this] { return pending_tasks == 0; });
+    }
+}
+
+void ThreadPool::Wait(TaskGroup& group) {
+    int own_queue = (current_pool == this) ? current_queue : -1;
+    while (group.pending > 0) {
+        QueuedTask task;
+        if (PopGroupTask(own_queue, group, task)) {
+            RunTask(task);
+            continue;
+        }
+        // Zbylé úlohy skupiny běží na jiných vláknech - spát do dokončení
+        // nebo do odeslání další úlohy skupiny
+        std::unique_lock<std::mutex> lock(group.mutex);
+        group.changed.wait(lock, [&group] { return group.pending == 0 || group.queued > 0; });
+    }
+}
+
+bool ThreadPool::PopTask(int own_queue, QueuedTask& task) {
+    if (queued_tasks <= 0) return false;
+
+    // Vlastní fronta od konce (naposledy přidané úlohy)
+    if (own_queue >= 0) {
+        WorkerQueue& queue = *queues[own_queue];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.count > 0) {
+            queue.PopBack(task);
+            queued_tasks--;
+            if (task.group) task.group->queued--;
+            return true;
+        }
+    }
+
+    // Krádež nejstarší úlohy z cizí fronty
+    int count = (int)queues.size();
+    int start = (own_queue >= 0) ? own_queue + 1 : 0;
+    for (int i = 0; i < count; i++) {
+        int index = (start + i) % count;
+        if (index == own_queue) continue;
+        WorkerQueue& queue = *queues[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.count > 0) {
+            queue.PopFront(task);
+            queued_tasks--;
+            if (task.group) task.group->queued--;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ThreadPool::PopGroupTask(int own_queue, TaskGroup& group, QueuedTask& task) {
+    if (group.queued <= 0) return false;
+
+    // Nejdřív vlastní fronta, pak ostatní
+    int count = (int)queues.size();
+    int start = (own_queue >= 0) ? own_queue : 0;
+    for (int i = 0; i < count; i++) {
+        WorkerQueue& queue = *queues[(start + i) % count];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.PopGroup(&group, task)) {
+            queued_tasks--;
+            group.queued--;
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::WorkerQueue::PushBack(QueuedTask&& task) {
+    if (count == tasks.size()) {
+        std::vector<QueuedTask> grown(tasks.size() * 2);
+        for (size_t i = 0; i < count; i++) grown[i] = std::move(tasks[(head + i) % tasks.size()]);
+        tasks.swap(grown);
+        head = 0;
+    }
+    tasks[(head + count) % tasks.size()] = std::move(task);
+    count++;
+}
+
+void ThreadPool::WorkerQueue::PopBack(QueuedTask& task) {
+    count--;
+    task = std::move(tasks[(head + count) % tasks.size()]);
+}
+
+void ThreadPool::WorkerQueue::PopFront(QueuedTask& task) {
+    task = std::move(tasks[head]);
+    head = (head + 1) % tasks.size();
+    count--;
+}
+
+bool ThreadPool::WorkerQueue::PopGroup(const TaskGroup* group, QueuedTask& task) {
+    size_t size = tasks.size();
+    for (size_t i = count; i-- > 0;) {
+        if (tasks[(head + i) % size].group != group) continue;
+        task = std::move(tasks[(head + i) % size]);
+        // Zavřít mezeru posunutím novějších úloh
+        for (size_t j = i; j + 1 < count; j++) {
+            tasks[(head + j) % size] = std::move(tasks[(head + j + 1) % size]);
+        }
+        count--;
+        return true;
+    }
+    return false;
+}
+
+void ThreadPool::RunTask(QueuedTask& task) {
+    TaskGroup* group = task.group;
+    task.work();
+    task.work = nullptr;
+
+    if (group && --group->pending == 0) {
+        std::lock_guard<std::mutex> lock(group->mutex);
+        group->changed.notify_all();
+    }
+
+    if (--pending_tasks == 0) {
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+        tasks_finished.notify_all();
+    }
+}
+
+void ThreadPool::WorkerLoop(int index) {
+    current_pool = this;
+    current_queue = index;
+
+    for (;;) {
+        QueuedTask task;
+        if (PopTask(index, task)) {
+            RunTask(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleep_mutex);
+        // Při ukončení nejdříve dokončit zbývající fronty
+        if (stopping && queued_tasks <= 0) return;
+        task_available.wait(lock, [this] { return stopping || queued_tasks > 0; });
+    }
+}
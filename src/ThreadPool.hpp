@@ -0,0 +1,161 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Skupina úloh se společným čekáním (jedna dávka odeslaných úloh).
+ * Počítá nedokončené úlohy skupiny, takže Wait(group) neblokuje na cizí
+ * práci v poolu (např. načítání assetů).
+ */
+class TaskGroup {
+public:
+    TaskGroup() : pending(0), queued(0) {}
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+private:
+    friend class ThreadPool;
+
+    std::atomic<int> pending;          // Nedokončené úlohy skupiny
+    std::atomic<int> queued;           // Úlohy skupiny čekající ve frontách
+    std::mutex mutex;                  // Zámek pro uspávání čekajícího vlákna
+    std::condition_variable changed;   // Signál nové nebo dokončené úlohy skupiny
+};
+
+/**
+ * Pool pracovních vláken s kradením práce (work stealing).
+ * Každé vlákno má vlastní frontu: úlohy odeslané z pracovního vlákna jdou
+ * do jeho fronty a zpracuje je přednostně samo (od konce, data jsou ještě
+ * v cache), úlohy odeslané zvenku se rozdělují po frontách dokola.
+ * Vlákno bez práce krade nejstarší úlohy z cizích front. Úlohy lze odeslat
+ * do skupiny (TaskGroup); Wait(group) pak čeká jen na úlohy této skupiny
+ * a čekající vlákno mezitím samo zpracovává jen je.
+ */
+class ThreadPool {
+public:
+    /**
+     * Konstruktor - spustí pracovní vlákna.
+     * @param thread_count Počet vláken (0 = podle počtu jader CPU)
+     */
+    explicit ThreadPool(unsigned int thread_count = 0);
+
+    /**
+     * Destruktor - dokončí fronty a ukončí všechna vlákna.
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * Přidá úlohu do fronty.
+     * @param task Úloha ke zpracování na některém z vláken
+     * @param group Skupina, do které úloha patří (nullptr = bez skupiny)
+     */
+    void Submit(std::function<void()> task, TaskGroup* group = nullptr);
+
+    /**
+     * Počká, dokud nejsou zpracovány všechny odeslané úlohy (ukončení hry).
+     */
+    void Wait();
+
+    /**
+     * Počká na dokončení úloh skupiny; volající vlákno mezitím zpracovává
+     * jen úlohy této skupiny. Lze volat i z úlohy běžící v poolu.
+     * @param group Skupina, na kterou se čeká
+     */
+    void Wait(TaskGroup& group);
+
+    /**
+     * @return Počet pracovních vláken
+     */
+    unsigned int GetThreadCount() const { return (unsigned int)workers.size(); }
+
+private:
+    /**
+     * Úloha ve frontě spolu se skupinou, do které patří.
+     */
+    struct QueuedTask {
+        std::function<void()> work;        // Práce úlohy
+        TaskGroup* group = nullptr;        // Skupina úlohy (nullptr = bez skupiny)
+    };
+
+    /**
+     * Fronta úloh jednoho pracovního vlákna - kruhový buffer, který roste jen
+     * při zaplnění (deque by při průchodu úloh alokovala a uvolňovala bloky).
+     */
+    struct WorkerQueue {
+        std::mutex mutex;                          // Zámek fronty (vlastník i zloději)
+        std::vector<QueuedTask> tasks;             // Kruhový buffer čekajících úloh
+        size_t head = 0;                           // Index nejstarší úlohy
+        size_t count = 0;                          // Počet čekajících úloh
+
+        WorkerQueue() : tasks(64) {}
+
+        /**
+         * Přidá úlohu na konec (při plném bufferu ho zdvojnásobí).
+         */
+        void PushBack(QueuedTask&& task);
+
+        /**
+         * Vyjme naposledy přidanou úlohu (fronta nesmí být prázdná).
+         */
+        void PopBack(QueuedTask& task);
+
+        /**
+         * Vyjme nejstarší úlohu (fronta nesmí být prázdná).
+         */
+        void PopFront(QueuedTask& task);
+
+        /**
+         * Vyjme naposledy přidanou úlohu dané skupiny (zbytek fronty posune).
+         * @return false pokud ve frontě žádná úloha skupiny není
+         */
+        bool PopGroup(const TaskGroup* group, QueuedTask& task);
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;  // Fronty, jedna na vlákno
+    std::vector<std::thread> workers;              // Pracovní vlákna
+    std::atomic<unsigned int> next_queue;          // Fronta pro další úlohu zvenku
+    std::atomic<int> queued_tasks;                 // Úlohy čekající ve frontách
+    std::atomic<int> pending_tasks;                // Počet nedokončených úloh
+    std::mutex sleep_mutex;                        // Zámek pro uspávání a probouzení
+    std::condition_variable task_available;        // Signál nové úlohy
+    std::condition_variable tasks_finished;        // Signál dokončení všech úloh
+    bool stopping;                                 // Příznak ukončení poolu
+
+    /**
+     * Vybere úlohu - nejdřív z konce vlastní fronty, pak ukradne ze začátku cizí.
+     * @param own_queue Index vlastní fronty (-1 = volající není pracovní vlákno)
+     * @param task Výstupní úloha
+     * @return false pokud nikde nic nečeká
+     */
+    bool PopTask(int own_queue, QueuedTask& task);
+
+    /**
+     * Vybere čekající úlohu dané skupiny z kterékoli fronty.
+     * @param own_queue Index vlastní fronty (-1 = volající není pracovní vlákno)
+     * @param group Skupina hledané úlohy
+     * @param task Výstupní úloha
+     * @return false pokud žádná úloha skupiny nečeká
+     */
+    bool PopGroupTask(int own_queue, TaskGroup& group, QueuedTask& task);
+
+    /**
+     * Zpracuje úlohu a ohlásí její dokončení (poolu i její skupině).
+     */
+    void RunTask(QueuedTask& task);
+
+    /**
+     * Smyčka pracovního vlákna - zpracovává a krade úlohy.
+     * @param index Index vlastní fronty
+     */
+    void WorkerLoop(int index);
+};
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+
+/**
+ * Lock-free trojitý buffer pro předávání snímků mezi jedním zapisovatelem
+ * a jedním čtenářem. Zapisovatel plní vlastní slot a po dokončení ho
+ * vymění s prostředním; čtenář si prostřední slot vezme, jen když obsahuje
+ * nový snímek. Žádná strana nikdy nečeká a čtenář vždy drží celý snímek.
+ * @tparam T Typ snímku (sloty se znovu používají, jejich vektory si drží kapacitu)
+ */
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() : write_index(1), read_index(0), middle(2) {}
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    /**
+     * @return Slot, do kterého zapisovatel skládá další snímek
+     */
+    T& GetWriteBuffer() { return slots[write_index]; }
+
+    /**
+     * Zveřejní zapsaný snímek (volá jen zapisovatel).
+     */
+    void Publish() {
+        write_index = middle.exchange(write_index | FRESH, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    /**
+     * Převezme nejnovější zveřejněný snímek, pokud nějaký přibyl (volá jen čtenář).
+     * @return true pokud se čtený snímek změnil
+     */
+    bool Update() {
+        if (!(middle.load(std::memory_order_acquire) & FRESH)) return false;
+        read_index = middle.exchange(read_index, std::memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+
+    /**
+     * @return Snímek, který drží čtenář
+     */
+    const T& GetReadBuffer() const { return slots[read_index]; }
+
+private:
+    static constexpr int INDEX_MASK = 3;   // Index slotu v middle
+    static constexpr int FRESH = 4;        // Příznak nového snímku v middle
+
+    T slots[3];
+    int write_index;                       // Slot zapisovatele
+    int read_index;                        // Slot čtenáře
+    std::atomic<int> middle;               // Prostřední slot + příznak FRESH
+};
@@ -1,4 +1,5 @@
 #include "Utils.hpp"
+#include "Constants.hpp"
 #include <algorithm>
 
 Color BlendColors(Color c1, Color c2, float blend) {
@@ -31,3 +32,24 @@ Color DarkenColor(Color c, float factor) {
 Color ColorWithAlpha(Color c, unsigned char alpha) {
     return {c.r, c.g, c.b, alpha};
 }
+
+int GetColorIndex(Color c) {
+    for (int i = 0; i < PALETTE_SIZE; i++) {
+        if (ALL_COLORS[i].r == c.r && ALL_COLORS[i].g == c.g && ALL_COLORS[i].b == c.b) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool IsSupportedBoardSize(int width, int height) {
+    if (width % PARTICLES_PER_BLOCK != 0 || height % PARTICLES_PER_BLOCK != 0) return false;
+    int blocks_width = width / PARTICLES_PER_BLOCK;
+    int blocks_height = height / PARTICLES_PER_BLOCK;
+    return blocks_width >= MIN_BOARD_WIDTH && blocks_width <= MAX_BOARD_WIDTH &&
+           blocks_height >= MIN_BOARD_HEIGHT && blocks_height <= MAX_BOARD_HEIGHT;
+}
+
+bool IsSupportedColorCount(int num_colors) {
+    return num_colors == 3 || num_colors == 4 || num_colors == 6;
+}
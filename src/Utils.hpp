@@ -34,3 +34,26 @@ Color DarkenColor(Color c, float factor);
  * @return Barva s upravenou průhledností
  */
 Color ColorWithAlpha(Color c, unsigned char alpha);
+
+/**
+ * Najde index barvy v paletě ALL_COLORS (porovnává RGB složky).
+ * @param c Hledaná barva
+ * @return Index v paletě, nebo -1 pokud barva v paletě není
+ */
+int GetColorIndex(Color c);
+
+/**
+ * Ověří rozměry desky v částicích (uložená hra, vysílání): celé buňky
+ * v rozsahu MIN_BOARD_* až MAX_BOARD_*.
+ * @param width Šířka v buňkách částic
+ * @param height Výška v buňkách částic
+ * @return true pokud takovou desku hra umí vytvořit
+ */
+bool IsSupportedBoardSize(int width, int height);
+
+/**
+ * Ověří počet barev (uložená hra, vysílání) - jen obtížnosti z nastavení.
+ * @param num_colors Počet barev
+ * @return true pro 3, 4 nebo 6 barev
+ */
+bool IsSupportedColorCount(int num_colors);
@@ -0,0 +1,212 @@
+#include "Versus.hpp"
+#include "Constants.hpp"
+#include <algorithm>
+
+Versus::Versus(ThreadPool& pool, unsigned int seed) : winner(-1), pool(pool) {
+    for (VersusPlayer& player : players) {
+        player.board = new Board();
+        player.current_tetromino = nullptr;
+        player.rng.seed(seed);
+        player.next_tetromino = new Tetromino(0, 0, player.rng);
+        player.input = {};
+        player.score = 0;
+        player.game_over = false;
+        player.fall_counter = 0;
+        player.current_fall_speed = FALL_SPEED;
+        player.waiting_for_settlement = false;
+        player.garbage_in = 0;
+        player.garbage_out = 0;
+        player.explosion_group_size = 0;
+        player.landing_cooldown = 0;
+        // Pracovní seznamy předem - tick hráče nealokuje
+        player.sounds.reserve(16);
+        player.garbage_columns.reserve(player.board->width);
+        player.garbage_grains.reserve(player.board->width * 4 * PARTICLES_PER_BLOCK);
+        SpawnTetromino(player);
+    }
+    players[1].input.player = 1;
+
+    int left = tick_graph.AddTask([this] { StepPlayer(players[0]); });
+    int right = tick_graph.AddTask([this] { StepPlayer(players[1]); });
+    tick_graph.AddTask([this] { ExchangeGarbage(); }, {left, right});
+}
+
+Versus::~Versus() {
+    for (VersusPlayer& player : players) {
+        delete player.board;
+        delete player.current_tetromino;
+        delete player.next_tetromino;
+    }
+}
+
+void Versus::AddInput(const TickInput& tick_input) {
+    TickInput& input = players[tick_input.player].input;
+    input.rotations += tick_input.rotations;
+    input.move_steps += tick_input.move_steps;
+    input.soft_drop = input.soft_drop || tick_input.soft_drop;
+}
+
+void Versus::Tick() {
+    if (winner >= 0) return;
+    for (VersusPlayer& player : players) player.sounds.clear();
+
+    tick_graph.Run(pool);
+
+    // Konec až po výměně - zasypou-li se oba ve stejném ticku, je to remíza
+    if (players[0].game_over || players[1].game_over) {
+        winner = (players[0].game_over && players[1].game_over) ? 2 : (players[0].game_over ? 1 : 0);
+    }
+}
+
+void Versus::SpawnTetromino(VersusPlayer& player) {
+    // Kostky se znovu používají - spawn během hry nealokuje
+    if (player.current_tetromino) player.current_tetromino->Reset(BOARD_WIDTH / 2 - 2, 0, player.rng);
+    else player.current_tetromino = new Tetromino(BOARD_WIDTH / 2 - 2, 0, player.rng);
+    player.current_tetromino->shape_type = player.next_tetromino->shape_type;
+    player.current_tetromino->color = player.next_tetromino->color;
+    player.current_tetromino->GenerateParticles();
+
+    player.next_tetromino->Reset(0, 0, player.rng);
+
+    if (player.board->CheckCollision(player.current_tetromino->particles)) {
+        player.game_over = true;
+    }
+}
+
+void Versus::ApplyInput(VersusPlayer& player) {
+    TickInput input = player.input;
+    player.input = {};
+    player.input.player = input.player;
+
+    Tetromino* piece = player.current_tetromino;
+    if (player.waiting_for_settlement || !piece || !piece->is_active) return;
+
+    for (int i = 0; i < input.rotations; i++) {
+        int old_rotation = piece->rotation;
+        piece->Rotate();
+        if (player.board->CheckCollision(piece->particles)) {
+            piece->rotation = old_rotation;
+            piece->GenerateParticles();
+        } else {
+            player.sounds.push_back({SfxId::ROTATE, 1.0f});
+        }
+    }
+
+    int dx = (input.move_steps < 0) ? -1 : 1;
+    for (int i = 0; i < std::abs(input.move_steps); i++) {
+        piece->Move(dx, 0);
+        if (player.board->CheckCollision(piece->particles)) {
+            piece->Move(-dx, 0);
+            break;
+        }
+    }
+
+    if (input.soft_drop) {
+        player.fall_counter = FALL_SPEED;
+    }
+}
+
+void Versus::StepPlayer(VersusPlayer& player) {
+    if (player.game_over) return;
+    Board& board = *player.board;
+    ApplyInput(player);
+
+    // Fáze ticku desky ve stejném pořadí jako Game::BuildUpdateGraph, jen za sebou -
+    // souběžně tu běží celé desky
+    Board::ExplosionState explosion_before = board.explosion_state;
+    board.BeginTick();
+    board.UpdateExplosions();
+    board.ApplyGravity();
+    board.UpdatePreExplosionAnimation();
+    board.UpdateShake();
+    int removed = board.CheckHorizontalConnections();
+
+    if (player.landing_cooldown > 0) player.landing_cooldown--;
+    if (board.landed_count > 0 && player.landing_cooldown == 0) {
+        player.sounds.push_back({SfxId::LANDING, std::min(1.0f, board.landed_count / 50.0f)});
+        player.landing_cooldown = 6;
+    }
+    if (explosion_before == Board::ExplosionState::ZOOMING && board.explosion_state == Board::ExplosionState::EXPLODING) {
+        player.sounds.push_back({SfxId::EXPLOSION, std::min(1.0f, player.explosion_group_size / 1500.0f)});
+    }
+
+    if (removed > 0) {
+        int combo = std::max(1, (int)board.exploding_groups.size());
+        player.score += removed * combo;
+        player.explosion_group_size = removed;
+        player.sounds.push_back({SfxId::CHARGE, 1.0f});
+
+        // Výbuch nejdřív ruší písek čekající na vlastní desce, zbytek jde soupeři
+        int sent = removed * combo / GARBAGE_DIVISOR;
+        int cancelled = std::min(sent, player.garbage_in);
+        player.garbage_in -= cancelled;
+        player.garbage_out += sent - cancelled;
+
+        int speed_level = player.score / 1000;
+        player.current_fall_speed = std::max(10, FALL_SPEED - (speed_level * 5));
+    }
+
+    if (player.waiting_for_settlement) {
+        if (board.AreAllParticlesSettled() && board.explosion_state == Board::ExplosionState::NONE) {
+            player.waiting_for_settlement = false;
+            SpawnTetromino(player);
+        }
+        return;
+    }
+
+    Tetromino* piece = player.current_tetromino;
+    if (!piece || !piece->is_active) return;
+
+    player.fall_counter++;
+    if (player.fall_counter >= player.current_fall_speed) {
+        player.fall_counter = 0;
+        piece->Move(0, 1);
+
+        if (board.CheckCollision(piece->particles)) {
+            piece->Move(0, -1);
+            for (auto& p : piece->particles) p.settled = false;
+            board.AddParticles(piece->particles);
+            player.sounds.push_back({SfxId::LOCK, 1.0f});
+            piece->is_active = false;
+
+            // Písek od soupeře padá až po dopadu kostky - další kostka počká i na něj
+            DropGarbage(player);
+            player.waiting_for_settlement = true;
+        }
+    }
+}
+
+void Versus::DropGarbage(VersusPlayer& player) {
+    if (player.garbage_in <= 0) return;
+    Board& board = *player.board;
+
+    // Barvy i sloupce z náhody desky - pořadí kostek hráčů zůstane stejné
+    std::uniform_int_distribution<> color_dist(0, NUM_COLORS - 1);
+    std::vector<int>& columns = player.garbage_columns;
+    std::vector<Particle>& grains = player.garbage_grains;
+    grains.clear();
+    int band = std::min(board.height, 4 * PARTICLES_PER_BLOCK);
+    for (int y = 0; y < band && (int)grains.size() < player.garbage_in; y++) {
+        columns.clear();
+        for (int x = 0; x < board.width; x++) {
+            if (board.grid[y][x] == nullptr) columns.push_back(x);
+        }
+        std::shuffle(columns.begin(), columns.end(), board.rng);
+        for (int x : columns) {
+            if ((int)grains.size() >= player.garbage_in) break;
+            grains.emplace_back((float)x, (float)y, ALL_COLORS[color_dist(board.rng)]);
+        }
+    }
+
+    player.garbage_in -= (int)grains.size();
+    board.AddParticles(grains);
+}
+
+void Versus::ExchangeGarbage() {
+    int to_right = players[0].garbage_out;
+    int to_left = players[1].garbage_out;
+    players[0].garbage_out = 0;
+    players[1].garbage_out = 0;
+    players[1].garbage_in += to_right;
+    players[0].garbage_in += to_left;
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "Board.hpp"
+#include "Tetromino.hpp"
+#include "ThreadPool.hpp"
+#include "TaskGraph.hpp"
+#include "InputSystem.hpp"
+#include "SfxMixer.hpp"
+#include <random>
+#include <vector>
+
+/**
+ * Zvukový efekt vzniklý v ticku hráče - přehraje ho až Game po ticku
+ * (mixer má jednoho producenta, hráči přitom běží souběžně).
+ */
+struct VersusSound {
+    SfxId id;           // Efekt
+    float intensity;    // Síla 0.0 - 1.0
+};
+
+/**
+ * Jeden hráč souboje - vlastní deska, kostky, skóre a náhoda.
+ * Tick hráče sahá jen na tuto strukturu, hráči tak mohou běžet souběžně.
+ */
+struct VersusPlayer {
+    Board* board;                    // Deska hráče (vlastní náhoda v Board::rng)
+    Tetromino* current_tetromino;    // Padající kostka
+    Tetromino* next_tetromino;       // Náhled další kostky
+    std::mt19937 rng;                // Náhoda pro kostky (oba hráči stejné semínko = stejné pořadí kostek)
+    TickInput input;                 // Ovládání nasbírané pro příští tick
+    int score;                       // Skóre
+    bool game_over;                  // Hráč se zasypal
+    int fall_counter;                // Počítadlo automatického pádu
+    int current_fall_speed;          // Ticky na posun kostky (zrychluje se se skóre)
+    bool waiting_for_settlement;     // Čeká na usazení částic před další kostkou
+    int garbage_in;                  // Písek od soupeře čekající na shození (částice)
+    int garbage_out;                 // Písek pro soupeře z tohoto ticku (předá ExchangeGarbage)
+    int explosion_group_size;        // Částice probíhajícího výbuchu (síla zvuku)
+    int landing_cooldown;            // Ticky do dalšího možného zvuku dopadu
+    std::vector<VersusSound> sounds; // Zvuky z posledního ticku
+    std::vector<int> garbage_columns;      // Pracovní volné sloupce řádku pro shození písku
+    std::vector<Particle> garbage_grains;  // Pracovní částice shazovaného písku
+};
+
+/**
+ * Lokální souboj dvou hráčů na jedné obrazovce.
+ * V každém ticku běží oba hráči souběžně na poolu (každý na svém vlákně) a
+ * po nich výměna písku - jediný bod, kde se hráči ovlivňují. Výbuch hráče
+ * nejdřív ruší písek čekající na jeho desce, zbytek pošle soupeři, kterému
+ * se písek sype na desku při dopadu jeho další kostky. Výsledek tak nezávisí
+ * na tom, který hráč doběhl dřív.
+ */
+class Versus {
+public:
+    VersusPlayer players[2];         // Levý (WASD) a pravý (šipky) hráč
+    int winner;                      // Vítěz (-1 = hraje se, 0/1 = hráč, 2 = remíza)
+
+    /**
+     * Konstruktor - vytvoří desky a první kostky obou hráčů (hlavní vlákno, desky kreslí pozadí).
+     * @param pool Pool, na kterém běží ticky hráčů
+     * @param seed Semínko pořadí kostek (společné pro oba hráče)
+     */
+    Versus(ThreadPool& pool, unsigned int seed);
+
+    /**
+     * Destruktor - uvolní desky a kostky.
+     */
+    ~Versus();
+
+    Versus(const Versus&) = delete;
+    Versus& operator=(const Versus&) = delete;
+
+    /**
+     * Přidá ovládání hráče (input.player) k ovládání pro příští tick.
+     * @param tick_input Ovládání z Game::ReadTickInput
+     */
+    void AddInput(const TickInput& tick_input);
+
+    /**
+     * Jeden tick souboje - oba hráči souběžně, pak výměna písku a vyhodnocení.
+     */
+    void Tick();
+
+private:
+    ThreadPool& pool;                // Pracovní vlákna
+    TaskGraph tick_graph;            // Tick hráčů a výměna písku po obou
+
+    /**
+     * Vytvoří další kostku hráče nahoře na desce; při kolizi hráč prohrál.
+     */
+    void SpawnTetromino(VersusPlayer& player);
+
+    /**
+     * Provede nasbírané ovládání - rotaci, posun a rychlý pád (jako Game::ApplyTickInput).
+     */
+    void ApplyInput(VersusPlayer& player);
+
+    /**
+     * Tick jednoho hráče - fáze desky za sebou, skóre a pád kostky (jako Game::Update).
+     * Sahá jen na hráče, běží souběžně s druhým.
+     */
+    void StepPlayer(VersusPlayer& player);
+
+    /**
+     * Nasype čekající písek od soupeře do horní části desky (po dopadu kostky).
+     * Najednou nejvýš pás čtyř buněk, zbytek počká na další kostku.
+     */
+    void DropGarbage(VersusPlayer& player);
+
+    /**
+     * Předá písek poslaný v tomto ticku soupeřům (po doběhnutí obou hráčů).
+     */
+    void ExchangeGarbage();
+};
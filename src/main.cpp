@@ -1,8 +1,60 @@
 #include "Game.hpp"
+#include "Constants.hpp"
+#include "FrameRecorder.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
 
 // Entry point - vytvoří hru a spustí hlavní loop
-int main() {
+int main(int argc, char** argv) {
+    // Volby příkazové řádky (ladicí nástroje)
+    const char* export_frame[3] = {nullptr, nullptr, nullptr};  // Záznam, tick a výstupní obrázek
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--record-frames" && i + 1 < argc) FRAME_RECORD_PATH = argv[++i];
+        else if (arg == "--export-frame" && i + 3 < argc) {
+            // Deska ze záznamu --record-frames v daném ticku jako obrázek, např. hra-001.bin 1200 tick.png
+            for (auto& value : export_frame) value = argv[++i];
+        }
+        else if (arg == "--capture" && i + 1 < argc) CAPTURE_PATH = argv[++i];
+        else if (arg == "--publish" && i + 1 < argc) SPECTATOR_PUBLISH_PATH = argv[++i];
+        else if (arg == "--spectate" && i + 1 < argc) SPECTATOR_VIEW_PATH = argv[++i];
+        else if (arg == "--threaded-sim") THREADED_SIMULATION = true;
+        else if (arg == "--das" && i + 1 < argc) MOVE_DAS_MS = std::max(0, std::atoi(argv[++i]));
+        else if (arg == "--arr" && i + 1 < argc) MOVE_ARR_MS = std::max(0, std::atoi(argv[++i]));
+        else if (arg == "--sim-budget" && i + 1 < argc) SIM_BUDGET_US = std::max(0, std::atoi(argv[++i]));
+        else if (arg == "--alloc-check" && i + 1 < argc) ALLOC_CHECK_TICKS = std::max(0, std::atoi(argv[++i]));
+        else if (arg == "--render-scale" && i + 1 < argc) {
+            // Vnitřní rozlišení, např. 0.5 = čtvrtina pixelů; do okna se zvětší bez vyhlazování
+            RENDER_SCALE = std::clamp((float)std::atof(argv[++i]), 1.0f / PARTICLE_SIZE, 1.0f);
+        }
+        else if (arg == "--board" && i + 1 < argc) {
+            // Rozměr desky v buňkách ve tvaru ŠÍŘKAxVÝŠKA, např. 100x200
+            int w = 0, h = 0;
+            if (std::sscanf(argv[++i], "%dx%d", &w, &h) == 2) {
+                BOARD_WIDTH = std::clamp(w, MIN_BOARD_WIDTH, MAX_BOARD_WIDTH);
+                BOARD_HEIGHT = std::clamp(h, MIN_BOARD_HEIGHT, MAX_BOARD_HEIGHT);
+            }
+        }
+    }
+
+    // Export snímku ze záznamu běží bez okna a hry
+    if (export_frame[0]) {
+        FrameStreamReader reader;
+        if (!reader.Open(export_frame[0])) {
+            std::fprintf(stderr, "Invalid frame recording: %s\n", export_frame[0]);
+            return 1;
+        }
+        int tick = std::atoi(export_frame[1]);
+        if (tick > reader.GetLastTick() || !reader.ExportTick(tick, export_frame[2])) {
+            std::fprintf(stderr, "Cannot export tick %s (last tick %d)\n", export_frame[1], reader.GetLastTick());
+            return 1;
+        }
+        return 0;
+    }
+
     Game game;  // Inicializace herního objektu
     game.Run(); // Spuštění hlavní herní smyčky
-    return 0;
+    return game.AllocationCheckFailed() ? 1 : 0;
 }